@@ -45,3 +45,142 @@ Mint linear_recurrence(const vector<Mint> &a, const vector<Mint> &c,
   P.coeff.resize(Q.size() - 1);
   return bostan_mori(P, Q, n);
 }
+
+// Bostan-Mori in the frequency domain (T::mod(): an NTT-friendly prime).
+// Requires NTT (number_theoretic_transform.hpp) and fps_internal::ntt_engine
+// (formal_power_series.hpp).
+//
+// P and Q (deg < L) are kept as NTTs of size 2L. Q(-x) is Q's transform with
+// adjacent values swapped, so a step is pointwise products, NTT::halve() to
+// size L, and NTT::extend() back to 2L: 4 transforms of size L per bit of n,
+// instead of two full multiplications.
+namespace bostan_mori_internal {
+
+template <typename T>
+struct State {
+  using u32 = NTT::u32;
+  NTT &ntt;
+  int L;
+
+  explicit State(int size) : ntt(fps_internal::ntt_engine<T>()), L(1) {
+    while (L < size) L <<= 1;
+  }
+
+  std::vector<u32> load(const std::vector<T> &f) const {
+    std::vector<u32> a(2 * L);
+    ntt.load(f.data(), f.size(), a.data(), 2 * L);
+    ntt.transform(a.data(), 2 * L);
+    return a;
+  }
+
+  // p <- P(x) Q(-x) with the parity of `odd`, halved and extended.
+  void step_p(std::vector<u32> &p, const std::vector<u32> &q, bool odd) const {
+    for (int i = 0; i < 2 * L; ++i) p[i] = ntt.mul(p[i], q[i ^ 1]);
+    ntt.halve(p.data(), 2 * L, odd);
+    ntt.extend(p.data(), L);
+  }
+
+  // q <- Q(x) Q(-x), halved and extended.
+  void step_q(std::vector<u32> &q) const {
+    for (int b = 0; b < L; ++b) q[b] = ntt.mul(q[2 * b], q[2 * b + 1]);
+    ntt.extend(q.data(), L);
+  }
+
+  // f(0) from the transform: the mean of the values.
+  T constant_term(const std::vector<u32> &a) const {
+    T sum = 0;
+    for (u32 v : a) sum += T(ntt.from_mont(v));
+    return sum / T(2 * L);
+  }
+};
+
+}  // namespace bostan_mori_internal
+
+// Returns [x^n] P(x)/Q(x). Q(0) must be invertible.
+// O(L log L log n) with L = max(P.size(), Q.size()).
+template <typename T>
+T bostan_mori_ntt(const std::vector<T> &P, const std::vector<T> &Q,
+                  long long n) {
+  assert(n >= 0 and not Q.empty() and Q[0] != T(0));
+  if (P.empty()) return 0;
+  const bostan_mori_internal::State<T> st(std::max(P.size(), Q.size()));
+  auto p = st.load(P), q = st.load(Q);
+  for (; n; n >>= 1) {
+    st.step_p(p, q, n & 1);
+    st.step_q(q);
+  }
+  return st.constant_term(p) / st.constant_term(q);
+}
+
+// [x^n] P(x)/Q(x) for each n in ns. The chain Q_0 = Q, Q_{j+1}(x^2) =
+// Q_j(x) Q_j(-x) does not depend on n and is computed once (memory:
+// 2L words per bit of max(ns)). The P steps are shared by queries with the
+// same lowest bits (a binary trie over n, lowest bit first), so a query costs
+// 2 transforms of size L per bit not shared with an earlier one.
+template <typename T>
+std::vector<T> bostan_mori_ntt(const std::vector<T> &P,
+                               const std::vector<T> &Q,
+                               const std::vector<long long> &ns) {
+  using u32 = NTT::u32;
+  assert(not Q.empty() and Q[0] != T(0));
+  std::vector<T> res(ns.size());
+  if (P.empty() or ns.empty()) return res;
+  const bostan_mori_internal::State<T> st(std::max(P.size(), Q.size()));
+  const long long nmax = *std::max_element(ns.begin(), ns.end());
+  assert(*std::min_element(ns.begin(), ns.end()) >= 0);
+  int bits = 0;
+  while ((nmax >> bits) > 0) ++bits;
+  std::vector<std::vector<u32>> qs{st.load(Q)};
+  std::vector<T> q0{Q[0]};  // Q_j(0)
+  for (int j = 0; j < bits; ++j) {
+    std::vector<u32> q = qs.back();
+    st.step_q(q);
+    q0.push_back(st.constant_term(q));
+    qs.push_back(std::move(q));
+  }
+
+  // p: transform of P_j; ids: queries whose lowest j bits led here.
+  auto rec = [&](auto &rec, int j, std::vector<u32> p,
+                 const std::vector<int> &ids) -> void {
+    std::vector<int> next[2];
+    for (int id : ids) {
+      const long long n = ns[id] >> j;
+      if (n == 0) {
+        res[id] = st.constant_term(p) / q0[j];
+      } else {
+        next[n & 1].push_back(id);
+      }
+    }
+    for (int odd = 0; odd < 2; ++odd) {
+      if (next[odd].empty()) continue;
+      std::vector<u32> child;
+      if (odd == 0 and not next[1].empty()) {
+        child = p;  // p is still needed for the odd branch
+      } else {
+        child = std::move(p);
+      }
+      st.step_p(child, qs[j], odd);
+      rec(rec, j + 1, std::move(child), next[odd]);
+    }
+  };
+  std::vector<int> ids(ns.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  rec(rec, 0, st.load(P), ids);
+  return res;
+}
+
+// linear_recurrence() on the frequency-domain Bostan-Mori, for many n.
+template <typename T>
+std::vector<T> linear_recurrence_ntt(const std::vector<T> &a,
+                                     const std::vector<T> &c,
+                                     const std::vector<long long> &ns) {
+  const int k = c.size();
+  assert(int(a.size()) >= k);
+  std::vector<T> q(k + 1);
+  q[0] = 1;
+  for (int i = 0; i < k; ++i) q[i + 1] = -c[i];
+  NTT &ntt = fps_internal::ntt_engine<T>();
+  std::vector<T> p = fps_internal::ntt_multiply(
+      ntt, std::vector<T>(a.begin(), a.begin() + k), q, k);
+  return bostan_mori_ntt(p, q, ns);
+}
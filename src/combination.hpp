@@ -4,6 +4,8 @@
 using Int = long long;
 using Mint = atcoder::modint1000000007;
 
+// Lazily growing tables. Convenient for single-threaded use; see
+// `Factorials` for a fixed table that can be shared across threads.
 namespace mints {
 
 std::vector<Mint> vec(std::initializer_list<Mint> v,
@@ -46,6 +48,63 @@ Mint binom(int n, int k) {
 }  // namespace mints
 using mints::binom;
 
+// Factorials, inverse factorials and inverses of [0, n].
+// Built in O(n) with a single modular inverse (requires n < mod).
+// Read-only after construction, so threads can share it without locking.
+template <typename T = Mint>
+struct Factorials {
+  std::vector<T> fact, ifact, inv;
+
+  explicit Factorials(int n) : fact(n + 1), ifact(n + 1), inv(n + 1) {
+    assert(0 <= n and n < T::mod());
+    fact[0] = 1;
+    for (int i = 1; i <= n; ++i) fact[i] = fact[i - 1] * i;
+    ifact[n] = fact[n].inv();
+    for (int i = n; i >= 1; --i) {
+      ifact[i - 1] = ifact[i] * i;
+      inv[i] = ifact[i] * fact[i - 1];
+    }
+  }
+
+  // Max value of n.
+  int size() const { return int(fact.size()) - 1; }
+
+  // nCk
+  T C(int n, int k) const {
+    if (k < 0 or k > n) return 0;
+    assert(n <= size());
+    return fact[n] * ifact[k] * ifact[n - k];
+  }
+
+  // nPk
+  T P(int n, int k) const {
+    if (k < 0 or k > n) return 0;
+    assert(n <= size());
+    return fact[n] * ifact[n - k];
+  }
+
+  // Returns [nC0, nC1, ..., nCk] where k = min(n, kmax).
+  // n can exceed size() as long as k <= size().
+  std::vector<T> binom_row(Int n, Int kmax = -1) const {
+    assert(n >= 0);
+    const Int k64 = (kmax < 0) ? n : std::min(n, kmax);
+    assert(k64 <= size());
+    const int k = k64;
+    std::vector<T> row(k + 1);
+    if (n <= size()) {
+      const T fn = fact[n];
+      for (int i = 0; i <= k; ++i) row[i] = fn * ifact[i] * ifact[n - i];
+    } else {
+      row[0] = 1;
+      const T tn = n;
+      for (int i = 1; i <= k; ++i) {
+        row[i] = row[i - 1] * (tn - (i - 1)) * inv[i];
+      }
+    }
+    return row;
+  }
+};
+
 // nPk
 Mint perm(int n, int k) {
   if (k < 0 || k > n) return 0;
@@ -131,6 +190,107 @@ struct BinomialCoeffSmallMod {
   }
 };
 
+// nCk mod p^q by Granville's theorem (generalization of Lucas' theorem).
+// https://web.archive.org/web/20170202003812/http://www.dms.umontreal.ca/~andrew/PDF/BinCoeff.pdf
+// Precomputation: O(p^q). Query: O(log_p(n)). n can be up to 10^18.
+struct BinomialCoeffPrimePower {
+  using u32 = unsigned;
+  using u64 = unsigned long long;
+
+  int p, q;
+  u32 pq;  // p^q
+  // (i!)_p: product of integers in [1, i] not divisible by p, mod p^q.
+  std::vector<u32> fact, ifact;
+
+  BinomialCoeffPrimePower(int p, int q) : p(p), q(q), pq(1) {
+    assert(p >= 2 and q >= 1);
+    for (int i = 0; i < q; ++i) {
+      assert(u64(pq) * p < (1ULL << 32));
+      pq *= p;
+    }
+    fact.resize(pq);
+    ifact.resize(pq);
+    fact[0] = 1;
+    for (u32 i = 1; i < pq; ++i) {
+      fact[i] = (i % p == 0) ? fact[i - 1] : u64(fact[i - 1]) * i % pq;
+    }
+    ifact[pq - 1] = inv_mod(fact[pq - 1], pq);
+    for (u32 i = pq - 1; i >= 1; --i) {
+      ifact[i - 1] = (i % p == 0) ? ifact[i] : u64(ifact[i]) * i % pq;
+    }
+  }
+
+  u32 operator()(Int n, Int k) const {
+    if (k < 0 or k > n) return 0;
+    Int r = n - k;
+    int e0 = 0;  // number of carries when adding k and r in base p.
+    int eq = 0;  // number of carries at the (q-1)-th digit or above.
+    u64 res = 1;
+    for (int i = 0; n > 0; ++i) {
+      res = res * fact[n % pq] % pq;
+      res = res * ifact[k % pq] % pq;
+      res = res * ifact[r % pq] % pq;
+      n /= p, k /= p, r /= p;
+      const int carry = int(n - k - r);
+      e0 += carry;
+      if (e0 >= q) return 0;
+      if (i + 1 >= q) eq += carry;
+    }
+    if ((p != 2 or q < 3) and (eq & 1)) res = (pq - res) % pq;
+    for (int i = 0; i < e0; ++i) res = res * p % pq;
+    return res;
+  }
+
+  static u32 inv_mod(u64 a, u64 m) {
+    long long x = a, y = m, u = 1, v = 0;
+    while (y) {
+      long long t = x / y;
+      x -= t * y, std::swap(x, y);
+      u -= t * v, std::swap(u, v);
+    }
+    assert(x == 1);
+    u %= (long long)m;
+    return (u < 0) ? u + m : u;
+  }
+};
+
+// nCk mod m for any modulus m (< 2^32), not necessarily prime.
+// Combines BinomialCoeffPrimePower for each p^q || m by CRT.
+// Precomputation: O(sum of p^q). Query: O(sum of log_p(n)).
+struct BinomialCoeffAnyMod {
+  using u32 = unsigned;
+  using u64 = unsigned long long;
+
+  u32 m;
+  std::vector<BinomialCoeffPrimePower> engines;
+  std::vector<u64> crt_coeff;  // ≡ 1 (mod p^q), ≡ 0 (mod m / p^q).
+
+  explicit BinomialCoeffAnyMod(u32 m) : m(m) {
+    assert(m >= 1);
+    u32 x = m;
+    for (u32 p = 2; u64(p) * p <= x; ++p) {
+      if (x % p != 0) continue;
+      int q = 0;
+      while (x % p == 0) x /= p, ++q;
+      engines.emplace_back(p, q);
+    }
+    if (x > 1) engines.emplace_back(x, 1);
+    for (const auto &e : engines) {
+      const u64 rest = m / e.pq;
+      crt_coeff.push_back(
+          rest * BinomialCoeffPrimePower::inv_mod(rest % e.pq, e.pq) % m);
+    }
+  }
+
+  u32 operator()(Int n, Int k) const {
+    u64 res = 0;
+    for (int i = 0; i < int(engines.size()); ++i) {
+      res = (res + engines[i](n, k) * crt_coeff[i]) % m;
+    }
+    return res;
+  }
+};
+
 // C[n][k] = nCk
 // Cretates a combination matrix using Pascal's triangle.
 // Time and space complexity: Θ(n^2)
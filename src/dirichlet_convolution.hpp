@@ -1,4 +1,5 @@
 #include <bits/stdc++.h>
+using Int = long long;
 
 // Updates `f[k]` for 1 <= k <= n in place by Dirichlet Convolution
 //   f = f * g
@@ -7,7 +8,7 @@ template <typename T>
 void dirichlet_convolution_inplace(std::vector<T>& f, const std::vector<T>& g,
                                    const int n,
                                    const std::vector<int>& primes) {
-  assert(N < (int)f.size() and N < (int)g.size());
+  assert(n < (int)f.size() and n < (int)g.size());
   for (int p : primes) {
     for (int i = n / p; i > 0; --i) {
       const int to = i * p;
@@ -29,3 +30,140 @@ std::vector<T> dirichlet_convolution(const std::vector<T>& f,
   dirichlet_convolution_inplace(ret, g, n, primes);
   return ret;
 }
+
+// Arithmetic function f stored by its prefix sums F(v) = sum_{i<=v} f(i) at
+// the floor values v = floor(n/k), for Dirichlet series arithmetic with a
+// huge n (e.g. Mertens function for n = 10^11).
+//
+// Values f(i) for i <= K (K ~ n^{2/3}) are kept as is ("dense"), and F(n/j)
+// for j <= L = n/(K+1), i.e. values > K, are kept separately ("large").
+// The large part of a product is computed by the hyperbola method:
+//   (f*g)'s prefix at v = sum_{i<=s} f(i)G(v/i) + g(i)F(v/i) - F(s)G(s)
+// where s = floor(sqrt(v)).
+//
+// Time: O(K log K + n / sqrt(K)) = O(n^{2/3} log n) per multiplication or
+// division.
+template <typename T>
+struct FloorDirichletSeries {
+  Int n, K, L;
+  std::vector<T> dense;  // f(i) for 0 <= i <= K (f(0) is unused)
+  std::vector<T> large;  // F(n/j) for 1 <= j <= L
+
+  // K for a given n. Dense values for the constructor are needed up to K.
+  static Int dense_size(Int n) {
+    Int K = std::pow((long double)n, 2.0L / 3);
+    return std::max({K, isqrt(n), Int(1)});
+  }
+
+  // f(i): the value at i <= K.
+  // prefix(v): sum_{i<=v} f(i) for v > K.
+  // Dense values of a multiplicative f can be made with
+  // multiplicative_table() (factorization.hpp).
+  template <class F, class Prefix>
+  FloorDirichletSeries(Int n, F f, Prefix prefix) : FloorDirichletSeries(n) {
+    for (Int i = 1; i <= K; ++i) dense[i] = f(i);
+    for (Int j = 1; j <= L; ++j) large[j] = prefix(n / j);
+  }
+
+  // zeta(s): f(i) = 1.
+  static FloorDirichletSeries zeta(Int n) {
+    return FloorDirichletSeries(
+        n, [](Int) { return T(1); }, [](Int v) { return T(v); });
+  }
+
+  // Identity of the Dirichlet convolution: f(1) = 1, f(i) = 0 otherwise.
+  static FloorDirichletSeries unit(Int n) {
+    return FloorDirichletSeries(
+        n, [](Int i) { return T(i == 1 ? 1 : 0); }, [](Int) { return T(1); });
+  }
+
+  // sum_{i<=v} f(i). v must be <= K (O(K)) or a floor value n/k (O(1)).
+  T prefix_sum(Int v) const {
+    if (v > K) {
+      assert(n / (n / v) == v);
+      return large[n / v];
+    }
+    T res = 0;
+    for (Int i = 1; i <= v; ++i) res += dense[i];
+    return res;
+  }
+
+  FloorDirichletSeries operator*(const FloorDirichletSeries& g) const {
+    assert(n == g.n);
+    FloorDirichletSeries h(n);
+    for (Int i = 1; i <= K; ++i) {
+      if (dense[i] == T(0)) continue;
+      for (Int j = 1; i * j <= K; ++j) {
+        h.dense[i * j] += dense[i] * g.dense[j];
+      }
+    }
+    const auto F = dense_prefix(), G = g.dense_prefix();
+    for (Int j = 1; j <= L; ++j) {
+      const Int v = n / j, s = isqrt(v);
+      T sum = -F[s] * G[s];
+      for (Int i = 1; i <= s; ++i) {
+        sum += dense[i] * g.at(v / i, j * i, G) +
+               g.dense[i] * at(v / i, j * i, F);
+      }
+      h.large[j] = sum;
+    }
+    return h;
+  }
+
+  // Returns h with h * g = f. g(1) must be invertible.
+  FloorDirichletSeries operator/(const FloorDirichletSeries& g) const {
+    assert(n == g.n);
+    FloorDirichletSeries h(n);
+    const T inv1 = T(1) / g.dense[1];
+    h.dense = dense;
+    for (Int i = 1; i <= K; ++i) {
+      h.dense[i] *= inv1;
+      if (h.dense[i] == T(0)) continue;
+      for (Int j = 2; i * j <= K; ++j) {
+        h.dense[i * j] -= h.dense[i] * g.dense[j];
+      }
+    }
+    const auto H = h.dense_prefix(), G = g.dense_prefix();
+    // h.large[j * i] (i >= 2) is ready when processing j in descending order.
+    for (Int j = L; j >= 1; --j) {
+      const Int v = n / j, s = isqrt(v);
+      T sum = large[j] + H[s] * G[s];
+      for (Int i = 1; i <= s; ++i) sum -= h.dense[i] * g.at(v / i, j * i, G);
+      for (Int i = 2; i <= s; ++i) sum -= g.dense[i] * h.at(v / i, j * i, H);
+      h.large[j] = sum * inv1;
+    }
+    return h;
+  }
+
+  FloorDirichletSeries& operator*=(const FloorDirichletSeries& g) {
+    return *this = *this * g;
+  }
+  FloorDirichletSeries& operator/=(const FloorDirichletSeries& g) {
+    return *this = *this / g;
+  }
+
+  // Dirichlet inverse (e.g. zeta -> Moebius).
+  FloorDirichletSeries inv() const { return unit(n) / *this; }
+
+ private:
+  explicit FloorDirichletSeries(Int n)
+      : n(n), K(dense_size(n)), L(n / (K + 1)), dense(K + 1), large(L + 1) {}
+
+  static Int isqrt(Int x) {
+    Int r = std::sqrt((long double)x);
+    while (r * r > x) --r;
+    while ((r + 1) * (r + 1) <= x) ++r;
+    return r;
+  }
+
+  std::vector<T> dense_prefix() const {
+    std::vector<T> res(K + 1);
+    for (Int i = 1; i <= K; ++i) res[i] = res[i - 1] + dense[i];
+    return res;
+  }
+
+  // F(w) for w = floor(n / idx), given the dense prefix sums.
+  T at(Int w, Int idx, const std::vector<T>& prefix) const {
+    return w <= K ? prefix[w] : large[idx];
+  }
+};
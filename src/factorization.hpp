@@ -1,21 +1,149 @@
 #include <bits/stdc++.h>
 using Int = long long;
 
-// Returns all divisors of n. O(sqrt(n)) + sorting.
-std::vector<Int> divisors(Int n) {
-  std::vector<Int> res;
-  for (Int k = 1; k * k <= n; ++k) {
-    if (n % k != 0) continue;
-    res.push_back(k);
-    Int q = n / k;
-    if (q != k) res.push_back(q);
+namespace factorization_internal {
+
+// Montgomery multiplication modulo an odd m < 2^63.
+struct Montgomery {
+  using u64 = unsigned long long;
+  using u128 = __uint128_t;
+
+  u64 m;
+  u64 m_inv;  // m^{-1} mod 2^64
+  u64 r2;     // 2^128 mod m
+
+  explicit Montgomery(u64 m) : m(m), m_inv(m), r2((-u128(m)) % m) {
+    for (int i = 0; i < 5; ++i) m_inv *= 2 - m * m_inv;
+  }
+
+  // t / 2^64 mod m in [0, m). Requires t < m * 2^64.
+  u64 reduce(u128 t) const {
+    const u64 h = u64((u128(u64(t) * m_inv) * m) >> 64);
+    const u64 hi = u64(t >> 64);
+    return (hi >= h) ? hi - h : hi - h + m;
+  }
+  u64 mul(u64 a, u64 b) const { return reduce(u128(a) * b); }
+  u64 add(u64 a, u64 b) const {
+    a += b;
+    return (a >= m) ? a - m : a;
+  }
+  u64 to_mont(u64 x) const { return mul(x, r2); }  // x < m
+};
+
+}  // namespace factorization_internal
+
+// Deterministic Miller-Rabin test for 64-bit integers.
+bool is_prime(Int n) {
+  if (n < 2) return false;
+  for (Int p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+    if (n % p == 0) return n == p;
+  }
+  if (n < 37 * 37) return true;
+  using u64 = unsigned long long;
+  const factorization_internal::Montgomery mt(n);
+  const u64 one = mt.to_mont(1), minus_one = mt.to_mont(n - 1);
+  u64 d = n - 1;
+  const int s = __builtin_ctzll(d);
+  d >>= s;
+  // Sufficient for n < 2^64. https://miller-rabin.appspot.com/
+  for (u64 a : {2, 325, 9375, 28178, 450775, 9780504, 1795265022}) {
+    a %= n;
+    if (a == 0) continue;
+    u64 x = one, base = mt.to_mont(a);
+    for (u64 e = d; e; e >>= 1) {
+      if (e & 1) x = mt.mul(x, base);
+      base = mt.mul(base, base);
+    }
+    if (x == one or x == minus_one) continue;
+    bool ok = false;
+    for (int i = 1; i < s; ++i) {
+      x = mt.mul(x, x);
+      if (x == minus_one) {
+        ok = true;
+        break;
+      }
+    }
+    if (not ok) return false;
+  }
+  return true;
+}
+
+// Returns a non-trivial factor of an odd composite n.
+// Pollard's rho with Brent's cycle detection. Expected O(n^{1/4}).
+Int pollard_rho(Int n) {
+  using u64 = unsigned long long;
+  assert(n % 2 == 1 and not is_prime(n));
+  const factorization_internal::Montgomery mt(n);
+  const u64 un = n;
+  auto absdiff = [](u64 x, u64 y) { return x > y ? x - y : y - x; };
+  constexpr int kBatch = 128;  // Number of steps per gcd.
+  for (u64 c0 = 1;; ++c0) {
+    const u64 c = mt.to_mont(c0);
+    auto f = [&](u64 x) { return mt.add(mt.mul(x, x), c); };
+    // Differences are in Montgomery form, i.e. multiplied by 2^64, which
+    // is coprime to n and does not change gcds.
+    u64 x = 0, y = mt.to_mont(2), ys = y, q = mt.to_mont(1), g = 1;
+    for (int r = 1; g == 1; r <<= 1) {
+      x = y;
+      for (int i = 0; i < r; ++i) y = f(y);
+      for (int k = 0; k < r and g == 1; k += kBatch) {
+        ys = y;
+        for (int i = 0; i < kBatch and i < r - k; ++i) {
+          y = f(y);
+          q = mt.mul(q, absdiff(x, y));
+        }
+        g = std::gcd(q, un);
+      }
+    }
+    if (g == un) {
+      // Overshot in the last batch. Retry step by step.
+      do {
+        ys = f(ys);
+        g = std::gcd(absdiff(x, ys), un);
+      } while (g == 1);
+    }
+    if (g != un) return g;
   }
-  std::sort(res.begin(), res.end());
-  return res;
 }
 
-// Factorizes a number into {prime, count} pairs. O(sqrt(n)).
+// Factorizes a number into {prime, count} pairs. Expected O(n^{1/4}).
 std::vector<std::pair<Int, int>> factorize(Int n) {
+  assert(n > 0);
+  std::vector<Int> primes;
+  for (Int p = 2; p < 64 and p * p <= n; p += 1 + (p & 1)) {
+    while (n % p == 0) {
+      n /= p;
+      primes.push_back(p);
+    }
+  }
+  std::vector<Int> stack;
+  if (n > 1) stack.push_back(n);
+  while (not stack.empty()) {
+    const Int x = stack.back();
+    stack.pop_back();
+    if (x < 64 * 64 or is_prime(x)) {
+      primes.push_back(x);  // no factors below 64.
+      continue;
+    }
+    const Int d = pollard_rho(x);
+    stack.push_back(d);
+    stack.push_back(x / d);
+  }
+  std::sort(primes.begin(), primes.end());
+  std::vector<std::pair<Int, int>> res;
+  for (Int p : primes) {
+    if (not res.empty() and res.back().first == p) {
+      ++res.back().second;
+    } else {
+      res.emplace_back(p, 1);
+    }
+  }
+  return res;
+}
+
+// Factorization by trial division. O(sqrt(n)).
+// Faster than `factorize()` for small n and needs no other snippets.
+std::vector<std::pair<Int, int>> factorize_naive(Int n) {
   assert(n > 0);
   std::vector<std::pair<Int, int>> res;
   for (Int k = 2; k * k <= n; ++k) {
@@ -52,10 +180,27 @@ std::vector<Int> enumerate_divisors(
   return res;
 }
 
-// On a large N, often faster than simple `divisors()`.
-std::vector<Int> divisors2(Int n) { return enumerate_divisors(factorize(n)); }
+// Returns all divisors of n in ascending order.
+// O(n^{1/4}) factorization + O(d(n)) + sorting.
+std::vector<Int> divisors(Int n) { return enumerate_divisors(factorize(n)); }
+
+// Same as divisors(); kept for existing callers.
+std::vector<Int> divisors2(Int n) { return divisors(n); }
+
+// Returns all divisors of n by trial division. O(sqrt(n)) + sorting.
+std::vector<Int> divisors_naive(Int n) {
+  std::vector<Int> res;
+  for (Int k = 1; k * k <= n; ++k) {
+    if (n % k != 0) continue;
+    res.push_back(k);
+    Int q = n / k;
+    if (q != k) res.push_back(q);
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
 
-// Moebius function in O(sqrt(n)).
+// Moebius function in O(n^{1/4}).
 int moebius(Int n) {
   int res = 1;
   for (auto [p, k] : factorize(n)) {
@@ -65,7 +210,7 @@ int moebius(Int n) {
   return res;
 }
 
-// Euler's phi function in O(sqrt(n)).
+// Euler's phi function in O(n^{1/4}).
 // Number of integers coprime to n (between 1 and n inclusive).
 Int totient(Int n) {
   Int res = n;
@@ -76,20 +221,67 @@ Int totient(Int n) {
   return res;
 }
 
-// Returns a table of divisor counts of integers <= n.
-std::vector<int> divisor_count_table(int n) {
+// Returns a table of a multiplicative function f over [0, n] in O(n).
+// f(p, k, pk) = f(p^k) for a prime p, k >= 1 and pk = p^k.
+// Each value is either f(p^k) or a product of two table entries:
+//   f(i) = f(i / low[i]) * f(low[i])
+// where low[i] is the power of the smallest prime in i (linear sieve).
+template <typename T, class F>
+std::vector<T> multiplicative_table(int n, F f) {
   assert(n >= 1);
-  std::vector<int> counts(n + 1, 2);  // 1 and self
-  counts[0] = 0;
-  counts[1] = 1;
-  for (int d = 2; d * 2 <= n; ++d) {
-    for (int x = d * 2; x <= n; x += d) {
-      ++counts[x];
+  std::vector<T> table(n + 1);
+  std::vector<unsigned> low(n + 1);
+  std::vector<int> primes;
+  table[1] = T(1);
+  for (int i = 2; i <= n; ++i) {
+    if (low[i] == 0) {
+      primes.push_back(i);
+      // Prime powers are set here and skipped by the sieve below.
+      int k = 1;
+      for (Int pk = i; pk <= n; pk *= i, ++k) {
+        low[pk] = pk;
+        table[pk] = f(i, k, int(pk));
+      }
+    }
+    for (const int p : primes) {
+      const Int ip = Int(i) * p;
+      if (ip > n) break;
+      if (i % p == 0) {
+        low[ip] = low[i] * p;
+        if (low[ip] != ip) table[ip] = table[ip / low[ip]] * table[low[ip]];
+        break;
+      }
+      low[ip] = p;
+      table[ip] = table[i] * table[p];
     }
   }
+  return table;
+}
+
+// Returns a table of divisor counts of integers <= n.
+std::vector<int> divisor_count_table(int n) {
+  auto counts =
+      multiplicative_table<int>(n, [](int, int k, int) { return k + 1; });
+  counts[0] = 0;
   return counts;
 }
 
+// Returns a table of sigma_k(i) = sum_{d|i} d^k for i <= n.
+// T: Int (k = 1 up to n ~ 10^8) or a modint.
+template <typename T = Int>
+std::vector<T> divisor_sigma_table(int n, int k = 1) {
+  return multiplicative_table<T>(n, [&](int p, int e, int) {
+    T q = 1;  // p^k
+    for (int i = 0; i < k; ++i) q *= T(p);
+    T res = 1, power = 1;
+    for (int i = 0; i < e; ++i) {
+      power *= q;
+      res += power;
+    }
+    return res;
+  });
+}
+
 // O(n) sieve
 struct PrimeSieve {
   std::vector<int> spf;  // smallest prime factors table.
@@ -246,54 +438,230 @@ std::vector<bool> prime_sieve(int n) {
   return is_prime;
 }
 
+// Segmented sieve of Eratosthenes for large n (10^10 and beyond).
+// Keeps one bit per odd number in L1-sized segments, so memory is
+// O(sqrt(n)) + 32KB per thread. Primes are streamed, never materialized.
+// Segments are split into contiguous chunks, one chunk per thread.
+struct SegmentedPrimeSieve {
+  using u64 = unsigned long long;
+  static constexpr int kSegmentBits = 1 << 18;  // 32KB
+  static constexpr int kSegmentWords = kSegmentBits / 64;
+
+  // Multiples of these primes are removed by copying a periodic pattern.
+  static constexpr int kPresieved[] = {3, 5, 7, 11, 13};
+  static constexpr int kPatternBits = 3 * 5 * 7 * 11 * 13;
+
+  Int n;
+  int num_threads;
+  std::vector<Int> base_primes;  // odd primes <= sqrt(n)
+  std::vector<u64> pattern_;     // kPresieved multiples cleared, repeated.
+
+  explicit SegmentedPrimeSieve(Int n, int num_threads = 1)
+      : n(n), num_threads(std::max(num_threads, 1)) {
+    Int r = std::sqrt((long double)std::max<Int>(n, 0));
+    while (r * r > n) --r;
+    while ((r + 1) * (r + 1) <= n) ++r;
+    const auto small = prime_sieve(std::max<Int>(r, 2));
+    for (Int p = 3; p <= r; p += 2) {
+      if (small[p]) base_primes.push_back(p);
+    }
+    // Bit i: 2i + 1. Long enough to copy a whole segment from any offset.
+    const int pattern_len = kPatternBits + kSegmentBits + 64;
+    pattern_.assign(pattern_len / 64 + 1, ~u64(0));
+    for (int p : kPresieved) {
+      for (int i = p / 2; i < pattern_len; i += p) {
+        pattern_[i >> 6] &= ~(u64(1) << (i & 63));
+      }
+    }
+  }
+
+  // Number of primes <= n.
+  Int count() const {
+    if (n < 2) return 0;
+    std::vector<Int> counts(num_threads);
+    for_each_segment([&](int tid, Int, const u64 *bits, int words) {
+      Int c = 0;
+      for (int i = 0; i < words; ++i) c += __builtin_popcountll(bits[i]);
+      counts[tid] += c;
+    });
+    return 1 + std::accumulate(counts.begin(), counts.end(), Int(0));
+  }
+
+  // Calls f(p) for all primes p <= n in ascending order.
+  // Runs on the calling thread regardless of num_threads.
+  template <class F>
+  void for_each(F f) const {
+    if (n < 2) return;
+    f(Int(2));
+    sieve_chunk(0, 0, num_segments(),
+                [&](int, Int lo, const u64 *bits, int words) {
+                  visit_bits(lo, bits, words, f);
+                });
+  }
+
+  // Calls f(tid, p) for all primes p <= n. f is called concurrently from
+  // `num_threads` threads (tid in [0, num_threads)). Primes in a thread
+  // come in ascending order, but there is no order across threads.
+  template <class F>
+  void for_each_parallel(F f) const {
+    if (n < 2) return;
+    f(0, Int(2));
+    for_each_segment([&](int tid, Int lo, const u64 *bits, int words) {
+      visit_bits(lo, bits, words, [&](Int p) { f(tid, p); });
+    });
+  }
+
+  // Calls f(tid, lo, bits, words) for each segment, concurrently.
+  // Bit i of `bits` tells whether lo + 2i is prime (only odd numbers).
+  // Bits for numbers > n are cleared.
+  template <class F>
+  void for_each_segment(F f) const {
+    const Int segs = num_segments();
+    if (num_threads == 1 or segs <= 1) {
+      sieve_chunk(0, 0, segs, f);
+      return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; ++t) {
+      const Int begin = segs * t / num_threads;
+      const Int end = segs * (t + 1) / num_threads;
+      workers.emplace_back([=, &f]() { sieve_chunk(t, begin, end, f); });
+    }
+    for (auto &w : workers) w.join();
+  }
+
+ private:
+  // Number of odd numbers <= n, divided into segments.
+  Int num_segments() const {
+    const Int odd_count = (n + 1) / 2;
+    return (odd_count + kSegmentBits - 1) / kSegmentBits;
+  }
+
+  template <class F>
+  static void visit_bits(Int lo, const u64 *bits, int words, F &&f) {
+    for (int i = 0; i < words; ++i) {
+      for (u64 w = bits[i]; w; w &= w - 1) {
+        f(lo + 2 * (Int(i) * 64 + __builtin_ctzll(w)));
+      }
+    }
+  }
+
+  // Sieves segments [seg_begin, seg_end) in order.
+  template <class F>
+  void sieve_chunk(int tid, Int seg_begin, Int seg_end, F &&f) const {
+    if (seg_begin >= seg_end) return;
+    std::vector<u64> bits(kSegmentWords);
+    std::vector<Int> next;  // next bit index to clear for each active prime.
+    next.reserve(base_primes.size());
+    const Int odd_count = (n + 1) / 2;
+    for (Int seg = seg_begin; seg < seg_end; ++seg) {
+      const Int lo = 2 * seg * kSegmentBits + 1;
+      const Int hi = lo + 2 * (kSegmentBits - 1);
+      // Activate primes whose square falls in or before this segment.
+      while (next.size() < base_primes.size()) {
+        const Int p = base_primes[next.size()];
+        if (p * p > hi) break;
+        Int m = std::max(p * p, (lo + p - 1) / p * p);
+        if (m % 2 == 0) m += p;
+        next.push_back((m - lo) / 2);
+      }
+      const int offset = (lo / 2) % kPatternBits;
+      const int shift = offset & 63;
+      for (int w = 0, k = offset >> 6; w < kSegmentWords; ++w, ++k) {
+        bits[w] = shift ? (pattern_[k] >> shift) |
+                              (pattern_[k + 1] << (64 - shift))
+                        : pattern_[k];
+      }
+      for (int j = std::size(kPresieved); j < int(next.size()); ++j) {
+        const Int p = base_primes[j];
+        Int i = next[j];
+        for (; i < kSegmentBits; i += p) bits[i >> 6] &= ~(u64(1) << (i & 63));
+        next[j] = i - kSegmentBits;
+      }
+      if (seg == 0) {
+        bits[0] &= ~u64(1);  // 1 is not a prime.
+        for (int p : kPresieved) bits[0] |= u64(1) << (p / 2);
+      }
+      int words = kSegmentWords;
+      const Int valid =
+          std::min<Int>(kSegmentBits, odd_count - seg * kSegmentBits);
+      if (valid < kSegmentBits) {
+        words = (valid + 63) / 64;
+        if (valid % 64) bits[words - 1] &= (u64(1) << (valid % 64)) - 1;
+      }
+      f(tid, lo, bits.data(), words);
+    }
+  }
+};
+
 // Factorization table for a segment [L, R).
+// The small prime factors of L+i are pool_[offset_[i], offset_[i+1]) (CSR).
+// The build runs twice per block of kBlock numbers: the first pass counts
+// factors and marks primes, the second fills the pool. With num_threads > 1,
+// the blocks are split into contiguous chunks built concurrently.
 class SegmentSieve {
+  using u32 = unsigned;
+  using u64 = unsigned long long;
+  static constexpr int kBlock = 1 << 15;  // multiple of 64
+
   Int L, R, max_spf_;
-  std::vector<Int> spf_;  // smallest prime factor for [0, max_spf_]
-  std::vector<std::vector<Int>> factors_;  // small prime factors of (L+i).
-  std::vector<Int> factors_prod_;  // product of small prime factors of (L+i).
+  std::vector<u32> spf_;         // smallest prime factor for [0, max_spf_]
+  std::vector<u32> primes_;      // primes p with p * p < R
+  std::vector<u32> offset_;      // size: R - L + 1
+  std::vector<u32> pool_;        // small prime factors in ascending order
+  std::vector<u64> prime_bits_;  // bit i: whether L+i is prime
 
  public:
-  SegmentSieve(Int l, Int r, Int m = 1) : L(l), R(r), max_spf_(m) {
+  SegmentSieve(Int l, Int r, Int m = 1, int num_threads = 1)
+      : L(l), R(r), max_spf_(m) {
+    assert(0 <= L and L <= R);
     while (__int128_t(max_spf_) * max_spf_ <= R)
       max_spf_ *= 2;  // Ensure max_spf > sqrt(R).
+    assert(max_spf_ <= std::numeric_limits<u32>::max());
     spf_.resize(max_spf_ + 1);
-    std::iota(spf_.begin(), spf_.end(), 0);
-    factors_.resize(R - L);
-    factors_prod_.assign(R - L, 1);
-
-    for (Int i = 2; i * i < R; ++i) {
+    std::iota(spf_.begin(), spf_.end(), 0U);
+    for (Int i = 2; i * i <= max_spf_; ++i) {
       if (spf_[i] != i) continue;
       for (Int j = i * i; j <= max_spf_; j += i) {
         if (spf_[j] == j) spf_[j] = i;
       }
-      for (Int j = (L + i - 1) / i * i; j < R; j += i) {
-        Int num = j;
-        do {
-          if (factors_prod_[j - L] > max_spf_) break;
-          factors_[j - L].push_back(i);
-          factors_prod_[j - L] *= i;
-          num /= i;
-        } while (num % i == 0);
-      }
     }
+    for (Int i = 2; i * i < R; ++i) {
+      if (spf_[i] == i) primes_.push_back(i);
+    }
+
+    const Int len = R - L;
+    offset_.assign(len + 1, 0);
+    prime_bits_.assign((len + 63) / 64, 0);
+    build(false, num_threads);  // offset_[i + 1] = number of factors of L+i
+    u64 total = 0;
+    for (Int i = 0; i < len; ++i) {
+      total += offset_[i + 1];
+      offset_[i + 1] = total;
+    }
+    assert(total <= std::numeric_limits<u32>::max());
+    pool_.resize(total);
+    build(true, num_threads);
   }
 
-  inline bool is_prime(int n) const {
+  inline bool is_prime(Int n) const {
     if (n <= 1) return false;
     if (n <= max_spf_) return spf_[n] == n;
     assert(L <= n and n < R);
-    auto p = factors_prod_[n - L];
-    return p == 1 or p == n;
+    const Int i = n - L;
+    return prime_bits_[i >> 6] >> (i & 63) & 1;
   }
 
   std::vector<Int> factorize(Int n) const {
     if (n <= 1) return {};
     assert(n <= max_spf_ or (L <= n and n < R));
     std::vector<Int> res;
-    if (n >= L) {
-      res = factors_[n - L];
-      n /= factors_prod_[n - L];
+    if (L <= n and n < R) {
+      const Int i = n - L;
+      for (u32 k = offset_[i]; k < offset_[i + 1]; ++k) {
+        res.push_back(pool_[k]);
+        n /= pool_[k];
+      }
       if (n > max_spf_) {
         res.push_back(n);  // n must be a large prime.
         n = 1;
@@ -306,4 +674,62 @@ class SegmentSieve {
     std::sort(res.begin(), res.end());
     return res;
   }
+
+ private:
+  void build(bool fill, int num_threads) {
+    const Int blocks = (R - L + kBlock - 1) / kBlock;
+    auto run = [&](Int begin, Int end) {
+      std::vector<Int> prod(kBlock);
+      std::vector<u32> pos(kBlock);
+      for (Int b = begin; b < end; ++b) sieve_block(b, fill, prod, pos);
+    };
+    if (num_threads <= 1 or blocks <= 1) {
+      run(0, blocks);
+      return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; ++t) {
+      const Int begin = blocks * t / num_threads;
+      const Int end = blocks * (t + 1) / num_threads;
+      workers.emplace_back([=, &run]() { run(begin, end); });
+    }
+    for (auto &w : workers) w.join();
+  }
+
+  // Blocks are aligned to 64, so threads never share a word of prime_bits_.
+  void sieve_block(Int b, bool fill, std::vector<Int> &prod,
+                   std::vector<u32> &pos) {
+    const Int lo = L + b * kBlock, hi = std::min(R, lo + kBlock);
+    const int n = hi - lo;
+    u32 *count = offset_.data() + (lo - L) + 1;
+    std::fill(prod.begin(), prod.begin() + n, 1);
+    if (fill) {
+      std::copy(offset_.begin() + (lo - L), offset_.begin() + (hi - L),
+                pos.begin());
+    }
+    for (const u32 p : primes_) {
+      for (Int j = (lo + p - 1) / p * p; j < hi; j += p) {
+        const int i = j - lo;
+        Int num = j;
+        do {
+          if (prod[i] > max_spf_) break;
+          if (fill) {
+            pool_[pos[i]++] = p;
+          } else {
+            ++count[i];
+          }
+          prod[i] *= p;
+          num /= p;
+        } while (num % p == 0);
+      }
+    }
+    if (fill) return;
+    for (int i = 0; i < n; ++i) {
+      const Int v = lo + i;
+      // No small factor, or v itself is a small prime.
+      if (v >= 2 and (count[i] == 0 or (count[i] == 1 and prod[i] == v))) {
+        prime_bits_[(v - L) >> 6] |= u64(1) << ((v - L) & 63);
+      }
+    }
+  }
 };
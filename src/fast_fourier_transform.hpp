@@ -1,4 +1,7 @@
 #include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 using namespace std;
 using Real = long double;
 
@@ -104,3 +107,252 @@ struct FastFourierTransform {
     return ret;
   }
 };
+
+// Double-precision FFT on split real/imaginary arrays (SoA).
+//   transform(): DIF, natural order in, bit-reversed order out.
+//   inverse():   DIT, bit-reversed order in, natural order out (times n).
+// Both use radix-4 butterflies (AVX2 when available) with one twiddle table
+//   w[b] = exp(-2πi rev(b) / 2N)  (b < N, rev: bit reversal in log2(N) bits)
+// whose prefix of length n/2 serves every size n <= 2N. No bit-reversal
+// pass is needed since pointwise products do not care about the order.
+struct DoubleFFT {
+  std::vector<double> wr, wi;          // twiddles
+  std::vector<double> buf_re, buf_im;  // workspace for multiply()
+
+  void transform(double *re, double *im, int n) {
+    assert((n & (n - 1)) == 0);
+    if (n <= 1) return;
+    ensure_twiddles(n / 2);
+    int len = n >> 1;
+    for (; len >= 2; len >>= 2) {
+      const int h = len >> 1;
+      for (int b = 0, s = 0; s < n; ++b, s += 2 * len) {
+        dif4(re + s, im + s, h, b);
+      }
+    }
+    if (len == 1) {
+      for (int b = 0; b < n / 2; ++b) {
+        const double xr = re[2 * b], xi = im[2 * b];
+        double yr = re[2 * b + 1], yi = im[2 * b + 1];
+        cmul(yr, yi, wr[b], wi[b]);
+        re[2 * b] = xr + yr, im[2 * b] = xi + yi;
+        re[2 * b + 1] = xr - yr, im[2 * b + 1] = xi - yi;
+      }
+    }
+  }
+
+  void inverse(double *re, double *im, int n) {
+    assert((n & (n - 1)) == 0);
+    if (n <= 1) return;
+    ensure_twiddles(n / 2);
+    int h = 1;
+    if (__builtin_ctz(n) & 1) {
+      for (int b = 0; b < n / 2; ++b) {
+        const double xr = re[2 * b], xi = im[2 * b];
+        const double yr = re[2 * b + 1], yi = im[2 * b + 1];
+        re[2 * b] = xr + yr, im[2 * b] = xi + yi;
+        double dr = xr - yr, di = xi - yi;
+        cmul(dr, di, wr[b], -wi[b]);
+        re[2 * b + 1] = dr, im[2 * b + 1] = di;
+      }
+      h = 2;
+    }
+    for (; 4 * h <= n; h <<= 2) {
+      for (int b = 0, s = 0; s < n; ++b, s += 4 * h) {
+        idif4(re + s, im + s, h, b);
+      }
+    }
+  }
+
+  // Convolution of real sequences with one complex transform of size n and
+  // one of size n/2: a and b are packed as re/im, and the real result is
+  // packed as even/odd before the inverse.
+  std::vector<double> multiply(const std::vector<double> &a,
+                               const std::vector<double> &b) {
+    if (a.empty() or b.empty()) return {};
+    const int need = a.size() + b.size() - 1;
+    int n = 2;
+    while (n < need) n <<= 1;
+    buf_re.assign(n, 0.0);
+    buf_im.assign(n, 0.0);
+    double *re = buf_re.data(), *im = buf_im.data();
+    std::copy(a.begin(), a.end(), re);
+    std::copy(b.begin(), b.end(), im);
+    transform(re, im, n);
+
+    // Z = A + iB. Position i holds Z[k] (k = rev(i)), and j holds Z[-k]:
+    // j = i for i < 2, and j = 3 * 2^t - 1 - i for i in [2^t, 2^{t+1}).
+    // A[k]B[k] = (Z[k]^2 - conj(Z[-k])^2) / 4i, conj of that at -k.
+    auto product = [&](int i, int j) {
+      const double p = re[i], q = im[i], r = re[j], s = im[j];
+      const double pr = (p * q + r * s) * 0.5;
+      const double pi = -(p * p - q * q - r * r + s * s) * 0.25;
+      re[i] = pr, im[i] = pi;
+      re[j] = pr, im[j] = -pi;
+    };
+    product(0, 0);
+    product(1, 1);
+    for (int t = 1; (2 << t) <= n; ++t) {
+      for (int i = 1 << t, j = (2 << t) - 1; i < j; ++i, --j) product(i, j);
+    }
+
+    // Even/odd split: C[k] and C[k + n/2] sit at 2m and 2m+1 (k = rev(m)).
+    //   W[k] = (C[k] + C[k+n/2]) + i (C[k] - C[k+n/2]) exp(2πik/n)
+    // and the inverse of W (size n/2) is n * (c[2m] + i c[2m+1]).
+    for (int m = 0; m < n / 2; ++m) {
+      const double ar = re[2 * m], ai = im[2 * m];
+      const double br = re[2 * m + 1], bi = im[2 * m + 1];
+      double dr = ar - br, di = ai - bi;
+      cmul(dr, di, wr[m], -wi[m]);
+      re[m] = ar + br - di;
+      im[m] = ai + bi + dr;
+    }
+    inverse(re, im, n / 2);
+    std::vector<double> res(need);
+    const double scale = 1.0 / n;
+    for (int i = 0; i < need; ++i) {
+      res[i] = ((i & 1) ? im[i >> 1] : re[i >> 1]) * scale;
+    }
+    return res;
+  }
+
+ private:
+  void ensure_twiddles(int half) {
+    int cur = wr.size();
+    if (cur >= half) return;
+    wr.resize(half), wi.resize(half);
+    if (cur == 0) wr[0] = 1, wi[0] = 0, cur = 1;
+    // b = 2^t + c: rev(b) / 2N = (2 rev_t(c) + 1) / 2^{t+2}.
+    for (int t = __builtin_ctz(cur); (1 << t) < half; ++t) {
+      for (int c = 0; c < (1 << t); ++c) {
+        int r = 0;
+        for (int k = 0; k < t; ++k) r |= ((c >> k) & 1) << (t - 1 - k);
+        const Real angle = -2 * PI * (2 * r + 1) / (Real(4) * (1 << t));
+        wr[(1 << t) + c] = std::cos(angle);
+        wi[(1 << t) + c] = std::sin(angle);
+      }
+    }
+  }
+
+  static void cmul(double &xr, double &xi, double yr, double yi) {
+    const double r = xr * yr - xi * yi;
+    xi = xr * yi + xi * yr;
+    xr = r;
+  }
+
+#ifdef __AVX2__
+  static void cmul(__m256d &xr, __m256d &xi, __m256d yr, __m256d yi) {
+    const __m256d r =
+        _mm256_sub_pd(_mm256_mul_pd(xr, yr), _mm256_mul_pd(xi, yi));
+    xi = _mm256_add_pd(_mm256_mul_pd(xr, yi), _mm256_mul_pd(xi, yr));
+    xr = r;
+  }
+#endif
+
+  // Two DIF stages on the block of size 4h: x0..x3 at j, j+h, j+2h, j+3h.
+  // The first stage uses w1 = w[b], the second w2 = w[2b] and
+  // w3 = w[2b+1] = -i w2.
+  void dif4(double *re, double *im, int h, int b) const {
+    const double w1r = wr[b], w1i = wi[b];
+    const double w2r = wr[2 * b], w2i = wi[2 * b];
+    const double w3r = w2i, w3i = -w2r;
+    double *r0 = re, *r1 = re + h, *r2 = re + 2 * h, *r3 = re + 3 * h;
+    double *i0 = im, *i1 = im + h, *i2 = im + 2 * h, *i3 = im + 3 * h;
+    int j = 0;
+#ifdef __AVX2__
+    const __m256d W1r = _mm256_set1_pd(w1r), W1i = _mm256_set1_pd(w1i);
+    const __m256d W2r = _mm256_set1_pd(w2r), W2i = _mm256_set1_pd(w2i);
+    const __m256d W3r = _mm256_set1_pd(w3r), W3i = _mm256_set1_pd(w3i);
+    for (; j + 4 <= h; j += 4) {
+      __m256d x0r = _mm256_loadu_pd(r0 + j), x0i = _mm256_loadu_pd(i0 + j);
+      __m256d x1r = _mm256_loadu_pd(r1 + j), x1i = _mm256_loadu_pd(i1 + j);
+      __m256d x2r = _mm256_loadu_pd(r2 + j), x2i = _mm256_loadu_pd(i2 + j);
+      __m256d x3r = _mm256_loadu_pd(r3 + j), x3i = _mm256_loadu_pd(i3 + j);
+      cmul(x2r, x2i, W1r, W1i);
+      cmul(x3r, x3i, W1r, W1i);
+      __m256d a0r = _mm256_add_pd(x0r, x2r), a0i = _mm256_add_pd(x0i, x2i);
+      __m256d a2r = _mm256_sub_pd(x0r, x2r), a2i = _mm256_sub_pd(x0i, x2i);
+      __m256d a1r = _mm256_add_pd(x1r, x3r), a1i = _mm256_add_pd(x1i, x3i);
+      __m256d a3r = _mm256_sub_pd(x1r, x3r), a3i = _mm256_sub_pd(x1i, x3i);
+      cmul(a1r, a1i, W2r, W2i);
+      cmul(a3r, a3i, W3r, W3i);
+      _mm256_storeu_pd(r0 + j, _mm256_add_pd(a0r, a1r));
+      _mm256_storeu_pd(i0 + j, _mm256_add_pd(a0i, a1i));
+      _mm256_storeu_pd(r1 + j, _mm256_sub_pd(a0r, a1r));
+      _mm256_storeu_pd(i1 + j, _mm256_sub_pd(a0i, a1i));
+      _mm256_storeu_pd(r2 + j, _mm256_add_pd(a2r, a3r));
+      _mm256_storeu_pd(i2 + j, _mm256_add_pd(a2i, a3i));
+      _mm256_storeu_pd(r3 + j, _mm256_sub_pd(a2r, a3r));
+      _mm256_storeu_pd(i3 + j, _mm256_sub_pd(a2i, a3i));
+    }
+#endif
+    for (; j < h; ++j) {
+      double x2r = r2[j], x2i = i2[j], x3r = r3[j], x3i = i3[j];
+      cmul(x2r, x2i, w1r, w1i);
+      cmul(x3r, x3i, w1r, w1i);
+      const double a0r = r0[j] + x2r, a0i = i0[j] + x2i;
+      const double a2r = r0[j] - x2r, a2i = i0[j] - x2i;
+      double a1r = r1[j] + x3r, a1i = i1[j] + x3i;
+      double a3r = r1[j] - x3r, a3i = i1[j] - x3i;
+      cmul(a1r, a1i, w2r, w2i);
+      cmul(a3r, a3i, w3r, w3i);
+      r0[j] = a0r + a1r, i0[j] = a0i + a1i;
+      r1[j] = a0r - a1r, i1[j] = a0i - a1i;
+      r2[j] = a2r + a3r, i2[j] = a2i + a3i;
+      r3[j] = a2r - a3r, i3[j] = a2i - a3i;
+    }
+  }
+
+  // Inverse of dif4() (times 4), with conjugated twiddles.
+  void idif4(double *re, double *im, int h, int b) const {
+    const double w1r = wr[b], w1i = -wi[b];
+    const double w2r = wr[2 * b], w2i = -wi[2 * b];
+    const double w3r = -w2i, w3i = w2r;
+    double *r0 = re, *r1 = re + h, *r2 = re + 2 * h, *r3 = re + 3 * h;
+    double *i0 = im, *i1 = im + h, *i2 = im + 2 * h, *i3 = im + 3 * h;
+    int j = 0;
+#ifdef __AVX2__
+    const __m256d W1r = _mm256_set1_pd(w1r), W1i = _mm256_set1_pd(w1i);
+    const __m256d W2r = _mm256_set1_pd(w2r), W2i = _mm256_set1_pd(w2i);
+    const __m256d W3r = _mm256_set1_pd(w3r), W3i = _mm256_set1_pd(w3i);
+    for (; j + 4 <= h; j += 4) {
+      __m256d y0r = _mm256_loadu_pd(r0 + j), y0i = _mm256_loadu_pd(i0 + j);
+      __m256d y1r = _mm256_loadu_pd(r1 + j), y1i = _mm256_loadu_pd(i1 + j);
+      __m256d y2r = _mm256_loadu_pd(r2 + j), y2i = _mm256_loadu_pd(i2 + j);
+      __m256d y3r = _mm256_loadu_pd(r3 + j), y3i = _mm256_loadu_pd(i3 + j);
+      __m256d a0r = _mm256_add_pd(y0r, y1r), a0i = _mm256_add_pd(y0i, y1i);
+      __m256d a1r = _mm256_sub_pd(y0r, y1r), a1i = _mm256_sub_pd(y0i, y1i);
+      __m256d a2r = _mm256_add_pd(y2r, y3r), a2i = _mm256_add_pd(y2i, y3i);
+      __m256d a3r = _mm256_sub_pd(y2r, y3r), a3i = _mm256_sub_pd(y2i, y3i);
+      cmul(a1r, a1i, W2r, W2i);
+      cmul(a3r, a3i, W3r, W3i);
+      __m256d x2r = _mm256_sub_pd(a0r, a2r), x2i = _mm256_sub_pd(a0i, a2i);
+      __m256d x3r = _mm256_sub_pd(a1r, a3r), x3i = _mm256_sub_pd(a1i, a3i);
+      cmul(x2r, x2i, W1r, W1i);
+      cmul(x3r, x3i, W1r, W1i);
+      _mm256_storeu_pd(r0 + j, _mm256_add_pd(a0r, a2r));
+      _mm256_storeu_pd(i0 + j, _mm256_add_pd(a0i, a2i));
+      _mm256_storeu_pd(r1 + j, _mm256_add_pd(a1r, a3r));
+      _mm256_storeu_pd(i1 + j, _mm256_add_pd(a1i, a3i));
+      _mm256_storeu_pd(r2 + j, x2r), _mm256_storeu_pd(i2 + j, x2i);
+      _mm256_storeu_pd(r3 + j, x3r), _mm256_storeu_pd(i3 + j, x3i);
+    }
+#endif
+    for (; j < h; ++j) {
+      const double a0r = r0[j] + r1[j], a0i = i0[j] + i1[j];
+      double a1r = r0[j] - r1[j], a1i = i0[j] - i1[j];
+      const double a2r = r2[j] + r3[j], a2i = i2[j] + i3[j];
+      double a3r = r2[j] - r3[j], a3i = i2[j] - i3[j];
+      cmul(a1r, a1i, w2r, w2i);
+      cmul(a3r, a3i, w3r, w3i);
+      double x2r = a0r - a2r, x2i = a0i - a2i;
+      double x3r = a1r - a3r, x3i = a1i - a3i;
+      cmul(x2r, x2i, w1r, w1i);
+      cmul(x3r, x3i, w1r, w1i);
+      r0[j] = a0r + a2r, i0[j] = a0i + a2i;
+      r1[j] = a1r + a3r, i1[j] = a1i + a3i;
+      r2[j] = x2r, i2[j] = x2i;
+      r3[j] = x3r, i3[j] = x3i;
+    }
+  }
+};
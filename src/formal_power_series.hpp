@@ -7,6 +7,11 @@
 //
 //   kRuntimeDMax = n;  // Set before creating an FPS object.
 //   DF f = {1};
+//
+// Requires:
+// - NTT (number_theoretic_transform.hpp) for NTTMult, DynamicNTTMult,
+//   ArbitraryModMult, exp_ntt and sqrt_fft
+// - DoubleFFT (fast_fourier_transform.hpp) for FloatMult
 
 #include <bits/stdc++.h>
 using Int = long long;
@@ -16,6 +21,112 @@ using Mint = atcoder::modint998244353;
 #include <atcoder/math>
 #include <atcoder/modint>
 
+namespace fps_internal {
+
+// NTT engine for T::mod(), one per thread (it caches roots). It is rebuilt
+// when the modulus of a dynamic modint has changed.
+// g: a primitive root of T::mod(), or 0 to compute it at runtime.
+template <typename T>
+NTT &ntt_engine(NTT::u32 g = 0) {
+  static thread_local NTT ntt(T::mod(), g);
+  if (ntt.mod != NTT::u32(T::mod())) ntt = NTT(T::mod(), g);
+  return ntt;
+}
+
+// Same as atcoder::internal::butterfly() / butterfly_inv() (not scaled by
+// 1/n), on the NTT engine. Outputs are in bit-reversed order as well.
+template <typename T>
+void butterfly(std::vector<T> &a) {
+  static thread_local std::vector<NTT::u32> buf;
+  NTT &ntt = ntt_engine<T>();
+  const int n = a.size();
+  buf.resize(n);
+  ntt.load(a.data(), n, buf.data(), n);
+  ntt.transform(buf.data(), n);
+  ntt.store(buf.data(), n, a.data());
+}
+
+template <typename T>
+void butterfly_inv(std::vector<T> &a) {
+  static thread_local std::vector<NTT::u32> buf;
+  NTT &ntt = ntt_engine<T>();
+  const int n = a.size();
+  buf.resize(n);
+  ntt.load(a.data(), n, buf.data(), n);
+  ntt.inverse(buf.data(), n, false);
+  ntt.store(buf.data(), n, a.data());
+}
+
+// Product of x and y truncated to `limit` terms.
+template <typename T>
+std::vector<T> ntt_multiply(NTT &ntt, const std::vector<T> &x,
+                            const std::vector<T> &y, int limit) {
+  using u32 = NTT::u32;
+  if (x.empty() or y.empty()) return {};
+  const int n = std::min<int>(x.size() + y.size() - 1, limit);
+  std::vector<T> res(n);
+  if (std::min(x.size(), y.size()) <= 32) {
+    for (int i = 0; i < std::min<int>(x.size(), n); ++i) {
+      for (int j = 0; j < int(y.size()) and i + j < n; ++j) {
+        res[i + j] += x[i] * y[j];
+      }
+    }
+    return res;
+  }
+  int sz = 1;
+  while (sz < int(x.size() + y.size() - 1)) sz <<= 1;
+  static thread_local std::vector<u32> fx, fy;
+  fx.resize(sz);
+  ntt.load(x.data(), x.size(), fx.data(), sz);
+  ntt.transform(fx.data(), sz);
+  if (&x == &y) {
+    ntt.pointwise(fx.data(), fx.data(), sz);  // squaring: one transform
+  } else {
+    fy.resize(sz);
+    ntt.load(y.data(), y.size(), fy.data(), sz);
+    ntt.transform(fy.data(), sz);
+    ntt.pointwise(fx.data(), fy.data(), sz);
+  }
+  ntt.inverse(fx.data(), sz);
+  ntt.store(fx.data(), n, res.data());
+  return res;
+}
+
+// 1/x mod x^sz by Newton's method: g <- g - (fg - 1)g. Each step of size m2
+// uses four transforms; the transform of g is shared by both products.
+template <typename T>
+std::vector<T> ntt_invert(NTT &ntt, const std::vector<T> &x, int sz) {
+  using u32 = NTT::u32;
+  const int n = x.size();
+  assert(n != 0 && x[0].val() != 0);  // must be invertible
+  assert(sz > 0);
+  int cap = 1;
+  while (cap < sz) cap <<= 1;
+  std::vector<u32> res(cap), f(cap), g(cap);
+  res[0] = ntt.to_mont(x[0].inv().val());
+  for (int m = 1, m2 = 2; m < sz; m = m2, m2 *= 2) {
+    ntt.load(x.data(), std::min(n, m2), f.data(), m2);
+    std::copy(res.begin(), res.begin() + m, g.begin());
+    std::fill(g.begin() + m, g.begin() + m2, 0);
+    ntt.transform(f.data(), m2);
+    ntt.transform(g.data(), m2);
+    ntt.pointwise(f.data(), g.data(), m2);
+    ntt.inverse(f.data(), m2);
+    // fg = 1 + x^m h: keep h.
+    std::copy(f.begin() + m, f.begin() + m2, f.begin());
+    std::fill(f.begin() + m, f.begin() + m2, 0);
+    ntt.transform(f.data(), m2);
+    ntt.pointwise(f.data(), g.data(), m2);
+    ntt.inverse(f.data(), m2);
+    for (int i = 0; i < m; ++i) res[m + i] = f[i] ? ntt.mod2 - f[i] : 0;
+  }
+  std::vector<T> ret(sz);
+  ntt.store(res.data(), sz, ret.data());
+  return ret;
+}
+
+}  // namespace fps_internal
+
 namespace multiplication {
 
 template <typename T, int DMAX>
@@ -53,47 +164,49 @@ struct NaiveMult {
   }
 };
 
-// T: modint
+// T: modint with a prime modulus p = c * 2^k + 1 < 2^30, e.g. 998244353,
+// 167772161, 469762049 or 754974721. The primitive root is computed at
+// compile time.
 template <typename T, int DMAX>
 struct NTTMult {
-  static_assert(atcoder::internal::is_modint<T>::value, "Requires ACL modint.");
-  static_assert(T::mod() == 998244353, "Requires an NTT-friendly mod.");
-  static_assert(DMAX <= (1 << 23), "Too big degrees for NTT.");
+  static constexpr NTT::u32 kMod = T::mod();
+  static_assert(kMod % 2 == 1 and kMod < (1u << 30),
+                "Requires an NTT-friendly mod.");
+  static_assert(DMAX <= ((kMod - 1) & -(kMod - 1)), "Too big degrees for NTT.");
+  static constexpr NTT::u32 kRoot = NTT::primitive_root(kMod);
 
   using value_type = T;
   static constexpr int dmax() { return DMAX; }
 
   static std::vector<T> multiply(const std::vector<T> &x,
                                  const std::vector<T> &y) {
-    std::vector<T> res = atcoder::convolution(x, y);
-    if (int(res.size()) > DMAX + 1) res.resize(DMAX + 1);  // shrink
-    return res;
+    NTT &ntt = fps_internal::ntt_engine<T>(kRoot);
+    return fps_internal::ntt_multiply(ntt, x, y, DMAX + 1);
   }
 
   static std::vector<T> invert(const std::vector<T> &x, int sz = -1) {
-    int n = x.size();
-    assert(n != 0 && x[0].val() != 0);  // must be invertible
     if (sz == -1) sz = dmax() + 1;
-    assert(sz > 0);
-    std::vector<T> res{x[0].inv()};
-    for (int m = 1, m2 = 2; m < sz; m = m2, m2 *= 2) {
-      std::vector<T> f(x.begin(), x.begin() + std::min(n, m2));
-      std::vector<T> g(res);
-      f.resize(m2), atcoder::internal::butterfly(f);
-      g.resize(m2), atcoder::internal::butterfly(g);
-      for (int i = 0; i < m2; ++i) f[i] *= g[i];
-      atcoder::internal::butterfly_inv(f);
-      f.erase(f.begin(), f.begin() + m);
-      f.resize(m2), atcoder::internal::butterfly(f);
-      for (int i = 0; i < m2; ++i) f[i] *= g[i];
-      atcoder::internal::butterfly_inv(f);
-      T iz = T(m2).inv();
-      iz *= -iz;
-      for (int i = 0; i < m; ++i) f[i] *= iz;
-      res.insert(res.end(), f.begin(), f.begin() + m);
-    }
-    res.resize(sz);
-    return res;
+    return fps_internal::ntt_invert(fps_internal::ntt_engine<T>(kRoot), x, sz);
+  }
+};
+
+// NTTMult for a prime chosen at runtime: T is a dynamic modint (e.g.
+// DynamicModInt in modint.hpp) whose modulus p = c * 2^k + 1 < 2^30 is set
+// before use. 2^k must be large enough for the transforms.
+template <typename T, int DMAX>
+struct DynamicNTTMult {
+  using value_type = T;
+  static constexpr int dmax() { return DMAX; }
+
+  static std::vector<T> multiply(const std::vector<T> &x,
+                                 const std::vector<T> &y) {
+    NTT &ntt = fps_internal::ntt_engine<T>();
+    return fps_internal::ntt_multiply(ntt, x, y, DMAX + 1);
+  }
+
+  static std::vector<T> invert(const std::vector<T> &x, int sz = -1) {
+    if (sz == -1) sz = dmax() + 1;
+    return fps_internal::ntt_invert(fps_internal::ntt_engine<T>(), x, sz);
   }
 };
 
@@ -123,7 +236,7 @@ struct FloatMult {
 
   static std::vector<value_type> multiply(const std::vector<value_type> &x,
                                           const std::vector<value_type> &y) {
-    FastFourierTransform<Real> fft;
+    static thread_local DoubleFFT fft;  // keeps twiddles and workspace
     auto res = fft.multiply(x, y);
     if (int(res.size()) > DMAX + 1) res.resize(DMAX + 1);  // shrink
     return res;
@@ -135,37 +248,48 @@ struct FloatMult {
 };
 
 // T: modint
+// Three-prime NTT (NTT engine, primes < 2^30) and Garner's CRT. Coefficients
+// of a product of length <= 2^23 with operands < 2^30 are below
+// M1 M2 M3 ~ 2^85.
+// Forward transforms are shared where possible: squaring takes 6 transforms
+// instead of 9, and each Newton step of invert() transforms g only once.
 template <typename T, int DMAX>
 struct ArbitraryModMult {
   using value_type = T;
+  using u32 = NTT::u32;
+  using u64 = unsigned long long;
   static_assert(atcoder::internal::is_modint<T>::value);
+  static_assert(DMAX < (1 << 23), "Too big degrees for NTT.");
 
   static constexpr int dmax() { return DMAX; }
 
+  static constexpr u32 M1 = 167772161, M2 = 469762049, M3 = 754974721;
+
+  // Transforms of one operand modulo M1, M2 and M3.
+  using Spectrum = std::array<std::vector<u32>, 3>;
+
   static std::vector<T> convolution(const std::vector<T> &x,
                                     const std::vector<T> &y, int size_limit) {
-    std::vector<int> xv(x.size());
-    std::vector<int> yv(y.size());
-    for (int i = 0; i < (int)x.size(); ++i) xv[i] = x[i].val();
-    for (int i = 0; i < (int)y.size(); ++i) yv[i] = y[i].val();
-
-    constexpr int M1 = 167772161, M2 = 469762049, M3 = 1224736769;
-    const auto z1 = atcoder::convolution<M1>(xv, yv);
-    const auto z2 = atcoder::convolution<M2>(xv, yv);
-    const auto z3 = atcoder::convolution<M3>(xv, yv);
-
-    const Int m1_inv_m2 = atcoder::inv_mod(M1, M2);
-    const Int m12_inv_m3 = atcoder::inv_mod(Int(M1) * M2, M3);
-    const Int m12 = Int(M1) * M2 % T::mod();
+    if (x.empty() or y.empty()) return {};
     const int n = std::min<int>(x.size() + y.size() - 1, size_limit);
     std::vector<T> res(n);
-    for (int i = 0; i < n; ++i) {
-      atcoder::static_modint<M2> v1 = z2[i] - z1[i];
-      v1 *= m1_inv_m2;
-      const Int w1 = v1.val() * Int(M1);
-      atcoder::static_modint<M3> v2 = z3[i] - z1[i] - w1;
-      v2 *= m12_inv_m3;
-      res[i] = z1[i] + w1 + (v2.val() * m12);
+    if (std::min(x.size(), y.size()) <= 32) {
+      for (int i = 0; i < std::min<int>(x.size(), n); ++i) {
+        for (int j = 0; j < int(y.size()) and i + j < n; ++j) {
+          res[i + j] += x[i] * y[j];
+        }
+      }
+      return res;
+    }
+    int sz = 1;
+    while (sz < int(x.size() + y.size() - 1)) sz <<= 1;
+    static thread_local Spectrum fx, fy;
+    forward(x.data(), x.size(), sz, fx);
+    if (&x == &y) {
+      backward(fx, fx, n, res.data());
+    } else {
+      forward(y.data(), y.size(), sz, fy);
+      backward(fx, fy, n, res.data());
     }
     return res;
   }
@@ -175,28 +299,69 @@ struct ArbitraryModMult {
     return convolution(x, y, dmax() + 1);
   }
 
+  // Newton's method as in NTTMult::invert(), with products taken mod T
+  // between the two steps.
   static std::vector<T> invert(const std::vector<T> &x, int sz = -1) {
     const int n = int(x.size());
     assert(n != 0 && x[0] != 0);
     if (sz == -1) sz = dmax() + 1;
     assert(sz > 0);
-    std::vector<T> res{x[0].inv()};
-    while (int(res.size()) < sz) {
-      const int m = res.size();
-      const int m2 = m << 1;
-      std::vector<T> f(x.begin(), x.begin() + std::min<int>(n, m2));
-      f.resize(m2);
-      res.resize(m2);
-      std::vector<T> s = convolution(f, res, m2);
-      s.resize(m2);
-      for (int i = 0; i < m2; i++) s[i] = -s[i];
-      s[0] += 2;
-      res = convolution(s, res, m2);
-      res.resize(m2);
+    int cap = 1;
+    while (cap < sz) cap <<= 1;
+    std::vector<T> res(cap), h(cap);
+    res[0] = x[0].inv();
+    Spectrum f, g;
+    for (int m = 1, m2 = 2; m < sz; m = m2, m2 *= 2) {
+      forward(x.data(), std::min(n, m2), m2, f);
+      forward(res.data(), m, m2, g);
+      backward(f, g, m2, h.data());
+      // fg = 1 + x^m h'  (h' = h[m..m2))
+      forward(h.data() + m, m, m2, f);
+      backward(f, g, m, h.data());
+      for (int i = 0; i < m; ++i) res[m + i] = -h[i];
     }
     res.resize(sz);
     return res;
   }
+
+ private:
+  static NTT &engine(int k) {
+    static thread_local NTT ntt[3] = {NTT(M1), NTT(M2), NTT(M3)};
+    return ntt[k];
+  }
+
+  // Transforms x[0..m) zero-padded to size sz.
+  static void forward(const T *x, int m, int sz, Spectrum &out) {
+    for (int k = 0; k < 3; ++k) {
+      NTT &ntt = engine(k);
+      std::vector<u32> &v = out[k];
+      v.resize(sz);
+      for (int i = 0; i < m; ++i) v[i] = ntt.to_mont(x[i].val());
+      std::fill(v.begin() + m, v.end(), 0);
+      ntt.transform(v.data(), sz);
+    }
+  }
+
+  // a <- a * b, inverted; res[i] = coefficient i mod T::mod() for i < n.
+  static void backward(Spectrum &a, const Spectrum &b, int n, T *res) {
+    const int sz = a[0].size();
+    for (int k = 0; k < 3; ++k) {
+      engine(k).pointwise(a[k].data(), b[k].data(), sz);
+      engine(k).inverse(a[k].data(), sz);
+    }
+    static const u64 m1_inv_m2 = atcoder::inv_mod(M1, M2);
+    static const u64 m12_inv_m3 = atcoder::inv_mod(u64(M1) * M2, M3);
+    const T m12 = T(u64(M1) * M2);
+    for (int i = 0; i < n; ++i) {
+      const u64 r1 = engine(0).from_mont(a[0][i]);
+      const u64 r2 = engine(1).from_mont(a[1][i]);
+      const u64 r3 = engine(2).from_mont(a[2][i]);
+      const u64 v1 = (r2 + M2 - r1) * m1_inv_m2 % M2;
+      const u64 x = r1 + v1 * M1;  // < M1 M2
+      const u64 v2 = (r3 + M3 - x % M3) * m12_inv_m3 % M3;
+      res[i] = T(x) + T(v2) * m12;
+    }
+  }
 };
 
 }  // namespace multiplication
@@ -591,6 +756,179 @@ T eval(const FPS &f, const T a) {
   return res;
 }
 
+// Subproduct tree of points a[0..n) for multipoint evaluation and
+// interpolation in O(n log^2 n). T::mod() must be an NTT-friendly prime
+// (see NTTMult).
+//   SubproductTree<Mint> tree(a);
+//   tree.evaluate(f);     // f(a[0]), ..., f(a[n-1])
+//   tree.interpolate(y);  // P of degree < n with P(a[i]) = y[i]
+//
+// Nodes hold Q_v(x) = prod_{i in v} (1 - a_i x); the leaves are padded to a
+// power of 2 with a = 0. Each Q_v of a node of size s is kept as its NTT of
+// size 2s, which is reused by both passes:
+// - Building: Q_v = Q_l Q_r. The product of the children's transforms is
+//   the lower half of the parent's, and transform_shifted() adds the upper
+//   half.
+// - evaluate(): transposed algorithm. The root gets the top coefficients of
+//   rev(f) / Q_root, and each child gets a middle product with its sibling's
+//   Q. A leaf ends up with [x^{N-1}] rev(f) / (1 - a_i x) = f(a_i).
+// - interpolate(): R_v = R_l Q_r + R_r Q_l for the weights c_i = y_i / M'(a_i)
+//   (M(x) = prod (x - a_i)), then P = rev(R_root).
+template <typename T>
+struct SubproductTree {
+  using u32 = NTT::u32;
+
+  int n;  // number of points
+  int m;  // number of leaves: 2^K >= n
+  int K;
+
+  explicit SubproductTree(const std::vector<T> &a)
+      : n(a.size()), m(1), K(0), ntt(fps_internal::ntt_engine<T>()) {
+    assert(n >= 1);
+    while (m < n) m <<= 1, ++K;
+    D.assign(K + 1, std::vector<u32>(2 * m));
+    const u32 one = ntt.to_mont(1);
+    for (int j = 0; j < m; ++j) {
+      D[0][2 * j] = one;
+      D[0][2 * j + 1] = j < n ? sub(0, ntt.to_mont(a[j].val())) : 0;
+      ntt.transform(&D[0][2 * j], 2);
+    }
+    q_root.assign(D[0].begin(), D[0].begin() + 2);  // K = 0: 1 - a_0 x
+    ntt.inverse(q_root.data(), 2);
+    std::vector<u32> buf;
+    for (int t = 0; t < K; ++t) {
+      const int s = 1 << t;
+      buf.resize(2 * s);
+      for (int v = 0; v < m; v += 2 * s) {
+        const u32 *l = &D[t][2 * v], *r = &D[t][2 * v + 2 * s];
+        u32 *p = &D[t + 1][2 * v];
+        std::copy(l, l + 2 * s, p);
+        ntt.pointwise(p, r, 2 * s);
+        std::copy(p, p + 2 * s, buf.begin());
+        ntt.inverse(buf.data(), 2 * s);
+        // buf = Q_p mod (x^{2s} - 1), and Q_p(0) = 1.
+        const u32 top = sub(buf[0], one);
+        if (t + 1 == K) {
+          q_root = buf;
+          q_root[0] = one;
+          q_root.push_back(top);
+        }
+        buf[0] = sub(one, top);  // Q_p(cx) mod (x^{2s} - 1), c^{2s} = -1
+        ntt.transform_shifted(buf.data(), 2 * s);
+        std::copy(buf.begin(), buf.end(), p + 2 * s);
+      }
+    }
+  }
+
+  // f(a[0]), ..., f(a[n-1]).
+  std::vector<T> evaluate(const std::vector<T> &f) const {
+    const int N = std::max<int>(f.size(), m);
+    std::vector<T> rev_f(N), q(m + 1);
+    for (int i = 0; i < int(f.size()); ++i) rev_f[N - 1 - i] = f[i];
+    ntt.store(q_root.data(), m + 1, q.data());
+    const std::vector<T> g = fps_internal::ntt_multiply(
+        ntt, rev_f, fps_internal::ntt_invert(ntt, q, N), N);
+    // w: for each node v of size s, [x^{N-s}, x^N) of rev(f) / Q_v.
+    std::vector<u32> w(m), x, y;
+    ntt.load(g.data() + (N - m), m, w.data(), m);
+    for (int t = K - 1; t >= 0; --t) {
+      const int s = 1 << t;
+      for (int v = 0; v < m; v += 2 * s) {
+        x.assign(w.begin() + v, w.begin() + v + 2 * s);
+        ntt.transform(x.data(), 2 * s);
+        y = x;
+        ntt.pointwise(x.data(), &D[t][2 * v + 2 * s], 2 * s);
+        ntt.pointwise(y.data(), &D[t][2 * v], 2 * s);
+        ntt.inverse(x.data(), 2 * s);
+        ntt.inverse(y.data(), 2 * s);
+        std::copy(x.begin() + s, x.end(), w.begin() + v);
+        std::copy(y.begin() + s, y.end(), w.begin() + v + s);
+      }
+    }
+    std::vector<T> res(n);
+    ntt.store(w.data(), n, res.data());
+    return res;
+  }
+
+  // The polynomial P of degree < n with P(a[i]) = y[i]. a must be distinct.
+  std::vector<T> interpolate(const std::vector<T> &y) const {
+    assert(int(y.size()) == n);
+    // M_k = [x^{n-k}] Q_root.
+    std::vector<T> q(n + 1), dm(n);
+    ntt.store(q_root.data(), n + 1, q.data());
+    for (int k = 1; k <= n; ++k) dm[k - 1] = q[n - k] * k;
+    std::vector<T> c = evaluate(dm);
+    // c[i] <- y[i] / c[i], with a single inversion (batch_inv() inline:
+    // this header does not depend on modint.hpp).
+    std::vector<T> prefix(n + 1);
+    prefix[0] = 1;
+    for (int i = 0; i < n; ++i) prefix[i + 1] = prefix[i] * c[i];
+    T acc = prefix[n].inv();
+    for (int i = n - 1; i >= 0; --i) {
+      const T ci = c[i];
+      c[i] = acc * prefix[i] * y[i];
+      acc *= ci;
+    }
+
+    // r: for each node v of size s, NTT of size 2s of R_v.
+    std::vector<u32> r(2 * m), next(2 * m), buf;
+    for (int j = 0; j < n; ++j) {
+      r[2 * j] = r[2 * j + 1] = ntt.to_mont(c[j].val());
+    }
+    buf.assign(r.begin(), r.begin() + 2);  // K = 0: R_root = c_0
+    ntt.inverse(buf.data(), 2);
+    for (int t = 0; t < K; ++t) {
+      const int s = 1 << t;
+      buf.resize(2 * s);
+      for (int v = 0; v < m; v += 2 * s) {
+        u32 *p = &next[2 * v];
+        std::copy(&r[2 * v], &r[2 * v] + 2 * s, p);
+        ntt.pointwise(p, &D[t][2 * v + 2 * s], 2 * s);
+        std::copy(&r[2 * v + 2 * s], &r[2 * v] + 4 * s, buf.begin());
+        ntt.pointwise(buf.data(), &D[t][2 * v], 2 * s);
+        for (int i = 0; i < 2 * s; ++i) p[i] = add(p[i], buf[i]);
+        std::copy(p, p + 2 * s, buf.begin());
+        ntt.inverse(buf.data(), 2 * s);
+        if (t + 1 == K) break;  // buf = R_root
+        ntt.transform_shifted(buf.data(), 2 * s);
+        std::copy(buf.begin(), buf.end(), p + 2 * s);
+      }
+      std::swap(r, next);
+    }
+    std::vector<T> res(n);
+    for (int k = 0; k < n; ++k) res[k] = T(ntt.from_mont(buf[n - 1 - k]));
+    return res;
+  }
+
+ private:
+  NTT &ntt;
+  std::vector<std::vector<u32>> D;  // D[t]: NTTs of Q_v for |v| = 2^t
+  std::vector<u32> q_root;          // coefficients of Q_root (m + 1)
+
+  u32 add(u32 a, u32 b) const {
+    const u32 x = a + b;
+    return x >= ntt.mod2 ? x - ntt.mod2 : x;
+  }
+  u32 sub(u32 a, u32 b) const {
+    const u32 x = a + ntt.mod2 - b;
+    return x >= ntt.mod2 ? x - ntt.mod2 : x;
+  }
+};
+
+// f(a[0]), ..., f(a[n-1]) in O((n + deg f) log^2 n).
+template <typename FPS, typename T = typename FPS::T>
+std::vector<T> multipoint_eval(const FPS &f, const std::vector<T> &a) {
+  if (a.empty()) return {};
+  return SubproductTree<T>(a).evaluate(f.coeff);
+}
+
+// The polynomial of degree < n through (x[i], y[i]) (x: distinct).
+template <typename FPS, typename T = typename FPS::T>
+FPS interpolate(const std::vector<T> &x, const std::vector<T> &y) {
+  assert(x.size() == y.size() and not x.empty());
+  return FPS(SubproductTree<T>(x).interpolate(y));
+}
+
 template <typename FPS, typename T = typename FPS::T>
 FPS derivative(const FPS &f) {
   std::vector<T> res(std::max<int>(f.size() - 1, 1));
@@ -600,6 +938,7 @@ FPS derivative(const FPS &f) {
   return FPS(std::move(res));
 }
 
+// 1/i by the recurrence 1/i = -(p / i) * 1/(p % i), with no inversion.
 template <typename FPS, typename T = typename FPS::T>
 FPS integral(const FPS &f, T c0 = 0) {
   const int n = int(f.size());
@@ -647,9 +986,9 @@ FPS exp(FPS g) {
   return ret;
 }
 
+// T::mod() must be an NTT-friendly prime (see NTTMult).
 template <typename FPS, typename T = typename FPS::T>
 FPS exp_ntt(FPS f) {
-  static_assert(T::mod() == 998244353, "Requires an NTT-friendly mod.");
   const int n = int(f.size());
   assert(n > 0 && f[0] == 0);
   std::vector<T> h_drv = std::move(derivative(f).coeff);
@@ -657,23 +996,23 @@ FPS exp_ntt(FPS f) {
   res[0] = 1;
   for (int m = 1; m < n; m <<= 1) {
     const int m2 = m << 1;
-    const T m2_inv = Mint(m2).inv();
+    const T m2_inv = T(m2).inv();
     std::vector<T> f_fft(res.begin(), res.begin() + m);
     std::vector<T> t = std::move(derivative(FPS(f_fft)).coeff);
     t.resize(m);
     f_fft.resize(m2);
-    atcoder::internal::butterfly(f_fft);
+    fps_internal::butterfly(f_fft);
 
     // Step 2.a'
     if (m > 1) {
       std::vector<T> _f(m);
       for (int i = 0; i < m; ++i) _f[i] = f_fft[i] * g_fft[i];
-      atcoder::internal::butterfly_inv(_f);
+      fps_internal::butterfly_inv(_f);
       _f.erase(_f.begin(), _f.begin() + (m >> 1));
       _f.resize(m);
-      atcoder::internal::butterfly(_f);
+      fps_internal::butterfly(_f);
       for (int i = 0; i < m; ++i) _f[i] *= g_fft[i];
-      atcoder::internal::butterfly_inv(_f);
+      fps_internal::butterfly_inv(_f);
       _f.resize(m / 2);
       T di = (T(-m) * m).inv();
       for (int i = 0, q = m >> 1; i < q; ++i) {
@@ -687,23 +1026,23 @@ FPS exp_ntt(FPS f) {
       std::vector<T> r(h_drv.begin(), h_drv.begin() + (m - 1));
       // Step 2.c'
       r.resize(m);
-      atcoder::internal::butterfly(r);
+      fps_internal::butterfly(r);
       for (int i = 0; i < m; ++i) r[i] *= f_fft[i];
-      atcoder::internal::butterfly_inv(r);
+      fps_internal::butterfly_inv(r);
       // Step 2.d'
-      auto mm = Mint(-m).inv();
+      auto mm = T(-m).inv();
       for (int i = 0; i < m; ++i) t[i] += r[i] * mm;
       std::rotate(t.begin(), t.begin() + (m - 1), t.end());
     }
 
     // Step 2.e'
     t.resize(m2);
-    atcoder::internal::butterfly(t);
+    fps_internal::butterfly(t);
     g_fft = g;
     g_fft.resize(m2);
-    atcoder::internal::butterfly(g_fft);
+    fps_internal::butterfly(g_fft);
     for (int i = 0; i < m2; ++i) t[i] *= g_fft[i];
-    atcoder::internal::butterfly_inv(t);
+    fps_internal::butterfly_inv(t);
     t.resize(m);
     for (auto &x : t) x *= m2_inv;
 
@@ -716,9 +1055,9 @@ FPS exp_ntt(FPS f) {
 
     // Step 2.g'
     v.resize(m2);
-    atcoder::internal::butterfly(v);
+    fps_internal::butterfly(v);
     for (int i = 0; i < m2; ++i) v[i] *= f_fft[i];
-    atcoder::internal::butterfly_inv(v);
+    fps_internal::butterfly_inv(v);
     v.resize(m);
     for (auto &x : v) x *= m2_inv;
 
@@ -764,6 +1103,105 @@ FPS pow_binexp(FPS base, Int t) {
   return res;
 }
 
+// f(x + c) in O(n log n) with one multiplication (n = f.size() <= T::mod()):
+//   [x^k] f(x + c) = 1/k! sum_{i>=k} (f_i i!) (c^{i-k} / (i-k)!).
+template <typename FPS, typename T = typename FPS::T>
+FPS taylor_shift(const FPS &f, const T c) {
+  const int n = f.size();
+  std::vector<T> fact(n), ifact(n);
+  fact[0] = 1;
+  for (int i = 1; i < n; ++i) fact[i] = fact[i - 1] * i;
+  ifact[n - 1] = fact[n - 1].inv();
+  for (int i = n - 1; i > 0; --i) ifact[i - 1] = ifact[i] * i;
+  std::vector<T> a(n), b(n);
+  for (int i = 0; i < n; ++i) a[n - 1 - i] = f[i] * fact[i];
+  T p = 1;
+  for (int j = 0; j < n; ++j, p *= c) b[j] = p * ifact[j];
+  const FPS ab = FPS(std::move(a)) * FPS(std::move(b));
+  std::vector<T> res(n);
+  for (int k = 0; k < n; ++k) res[k] = ab[n - 1 - k] * ifact[k];
+  return FPS(std::move(res));
+}
+
+// f(g(x)) mod x^n (n = dmax + 1 by default) in O(n log^2 n + m log m),
+// m = f.size(), by Kinoshita and Li's algorithm.
+// T::mod() must be an NTT-friendly prime (see NTTMult): the bivariate
+// products are longer than dmax and go to the NTT engine directly.
+//
+// f(g) = [y^{m-1}] rev(f)(y) / Q_0(x, y) with Q_0 = 1 - y g(x). Bostan-Mori
+// on x: Q_{k+1}(x^2, y) = Q_k(x, y) Q_k(-x, y), halving the x-degree and
+// doubling the y-degree down to Q_K(y). Going back up, only the y-window
+// [m - 2^k, m) of rev(f) / Q_k is needed at level k:
+//   W_k = window of Q_k(-x, y) W_{k+1}(x^2, y)  (a middle product in y).
+// Bivariate products use Kronecker substitution.
+template <typename FPS, typename T = typename FPS::T>
+FPS composition(const FPS &f, const FPS &g, int n = -1) {
+  if (n == -1) n = FPS::dmax() + 1;
+  const int m = f.size();
+  NTT &ntt = fps_internal::ntt_engine<T>();
+  auto multiply = [&](const std::vector<T> &a, const std::vector<T> &b) {
+    return fps_internal::ntt_multiply(ntt, a, b, a.size() + b.size() - 1);
+  };
+
+  // Level k: Q_k with x-degree < X[k], y-degree <= d[k] = 2^k, stored as
+  // q[k][j * X[k] + i] = [x^i y^j].
+  std::vector<std::vector<T>> q(1, std::vector<T>(2 * n));
+  std::vector<int> X{n}, d{1};
+  q[0][0] = 1;
+  for (int i = 0; i < std::min(n, g.size()); ++i) q[0][n + i] = -g[i];
+  while (X.back() > 1) {
+    const int x = X.back(), dy = d.back(), s = 2 * x;
+    std::vector<T> a((dy + 1) * s), b((dy + 1) * s);
+    for (int j = 0; j <= dy; ++j) {
+      for (int i = 0; i < x; ++i) {
+        a[j * s + i] = q.back()[j * x + i];
+        b[j * s + i] = (i & 1) ? -a[j * s + i] : a[j * s + i];
+      }
+    }
+    const std::vector<T> ab = multiply(a, b);
+    const int x2 = (x + 1) / 2, dy2 = 2 * dy;
+    std::vector<T> next((dy2 + 1) * x2);
+    for (int j = 0; j <= dy2; ++j) {
+      for (int i = 0; i < x2; ++i) next[j * x2 + i] = ab[j * s + 2 * i];
+    }
+    q.push_back(std::move(next));
+    X.push_back(x2), d.push_back(dy2);
+  }
+
+  // W_K: [y^{m-d_K}, y^m) of rev(f)(y) / Q_K(y).
+  const int K = X.size() - 1;
+  std::vector<T> rev_f(m);
+  for (int i = 0; i < m; ++i) rev_f[m - 1 - i] = f[i];
+  const std::vector<T> s = fps_internal::ntt_multiply(
+      ntt, rev_f, fps_internal::ntt_invert(ntt, q[K], m), m);
+  std::vector<T> w(d[K]);
+  for (int u = 0; u < d[K]; ++u) {
+    const int e = m - d[K] + u;
+    if (e >= 0) w[u] = s[e];
+  }
+
+  for (int k = K - 1; k >= 0; --k) {
+    // W_{k+1}: y-width 2 d[k], x-degree < X[k+1]. W_k: y-width d[k].
+    const int x = X[k], x1 = X[k + 1], dy = d[k], st = 2 * x;
+    std::vector<T> a((dy + 1) * st), b(2 * dy * st);
+    for (int j = 0; j <= dy; ++j) {
+      for (int i = 0; i < x; ++i) {
+        const T &c = q[k][j * x + i];
+        a[j * st + i] = (i & 1) ? -c : c;
+      }
+    }
+    for (int u = 0; u < 2 * dy; ++u) {
+      for (int i = 0; i < x1; ++i) b[u * st + 2 * i] = w[u * x1 + i];
+    }
+    const std::vector<T> ab = multiply(a, b);
+    w.assign(dy * x, 0);
+    for (int v = 0; v < dy; ++v) {
+      for (int i = 0; i < x; ++i) w[v * x + i] = ab[(dy + v) * st + i];
+    }
+  }
+  return FPS(std::move(w));
+}
+
 // \product_{i=0}^{N-1} (1 - x^a[i]) / (1 - x)
 // O((N+D)log(D))
 template <typename FPS, typename T = typename FPS::T>
@@ -823,16 +1261,16 @@ std::optional<Int> sqrt_mod(Int a, int p) {
   return x;
 }
 
+// T::mod() must be an NTT-friendly prime (see NTTMult).
 template <typename FPS, typename T = typename FPS::T>
 FPS sqrt_fft(const FPS &f_square) {
-  static_assert(T::mod() == 998244353, "Requires an NTT-friendly mod.");
   assert(f_square[0] == T(1));
-  static const T kHalf = T(1) / 2;
+  const T kHalf = T(1) / 2;  // not static: T may be a dynamic modint
   std::vector<T> f{1}, g{1}, z{1};
   T n2_inv = 1;
   for (int n = 1; n <= FPS::dmax(); n *= 2) {
     for (int i = 0; i < n; ++i) z[i] *= z[i];
-    atcoder::internal::butterfly_inv(z);
+    fps_internal::butterfly_inv(z);
     for (int i = 0; i < n; ++i) z[i] *= n2_inv;
 
     const int n2 = n * 2;
@@ -841,30 +1279,30 @@ FPS sqrt_fft(const FPS &f_square) {
     std::vector<T> delta(n2);
     for (int i = 0; i < n; ++i)
       delta[n + i] = z[i] - f_square[i] - f_square[n + i];
-    atcoder::internal::butterfly(delta);
+    fps_internal::butterfly(delta);
 
     std::vector<T> gbuf(n2);
     for (int i = 0; i < n; ++i) gbuf[i] = g[i];
-    atcoder::internal::butterfly(gbuf);
+    fps_internal::butterfly(gbuf);
 
     for (int i = 0; i < n2; ++i) delta[i] *= gbuf[i];
-    atcoder::internal::butterfly_inv(delta);
+    fps_internal::butterfly_inv(delta);
     for (int i = 0; i < n2; ++i) delta[i] *= n2_inv;
     f.resize(n2);
     for (int i = n; i < n2; ++i) f[i] = -delta[i] * kHalf;
     if (n2 > FPS::dmax()) break;
 
     z = f;
-    atcoder::internal::butterfly(z);
+    fps_internal::butterfly(z);
 
     std::vector<T> eps = gbuf;
     for (int i = 0; i < n2; ++i) eps[i] *= z[i];
-    atcoder::internal::butterfly_inv(eps);
+    fps_internal::butterfly_inv(eps);
     for (int i = 0; i < n; ++i) eps[i] = 0;
     for (int i = n; i < n2; ++i) eps[i] *= n2_inv;
-    atcoder::internal::butterfly(eps);
+    fps_internal::butterfly(eps);
     for (int i = 0; i < n2; ++i) eps[i] *= gbuf[i];
-    atcoder::internal::butterfly_inv(eps);
+    fps_internal::butterfly_inv(eps);
     for (int i = 0; i < n2; ++i) eps[i] *= n2_inv;
     g.resize(n2);
     for (int i = n; i < n2; ++i) g[i] -= eps[i];
@@ -897,3 +1335,58 @@ std::optional<FPS> sqrt(const FPS &f) {
   for (int i = zhalf; i < sz; ++i) res[i] = g[i - zhalf] * c0;
   return FPS(std::move(res));
 }
+
+// Online (relaxed) convolution h = f * g for recurrences where f_i and g_i
+// depend on h_0, ..., h_{i-1}:
+//   RelaxedConvolution<NTTMult<Mint, D>> rc;
+//   h_i = rc.push(f_i, g_i);  // i = 0, 1, 2, ...
+// Time: O(n log^2 n) for n pushes, with Mult::multiply for the blocks
+// (Mult::dmax() must be >= n).
+//
+// Terms f_j g_k with j, k >= 1 are grouped into s x s blocks with s = 2^t:
+// f[a, a+s) * g[s, 2s) for a >= s and g[a, a+s) * f[s, 2s) for a >= 2s
+// (a: a multiple of s).
+// A block is added right after index a+s-1 arrives, and its lowest term has
+// degree a+s. Terms with j = 0 or k = 0 are added directly.
+template <typename Mult>
+struct RelaxedConvolution {
+  using T = typename Mult::value_type;
+
+  std::vector<T> f, g, h;
+
+  int size() const { return f.size(); }
+
+  // Returns h_i, where i = size() before the call.
+  T push(const T &fi, const T &gi) {
+    const int i = f.size();
+    f.push_back(fi), g.push_back(gi);
+    if (int(h.size()) <= 2 * i) h.resize(2 * i + 1);
+    h[i] += (i == 0) ? fi * gi : fi * g[0] + f[0] * gi;
+    for (int s = 1; (i + 1) % s == 0 and 2 * s <= i + 1; s <<= 1) {
+      const int a = i + 1 - s;
+      add_block(f, a, g, s, s);
+      if (a != s) add_block(g, a, f, s, s);
+    }
+    return h[i];
+  }
+
+ private:
+  static constexpr int kNaiveThreshold = 32;
+
+  // h[xa + ya + k] += (x[xa, xa+s) * y[ya, ya+s))[k]
+  void add_block(const std::vector<T> &x, int xa, const std::vector<T> &y,
+                 int ya, int s) {
+    T *out = h.data() + xa + ya;
+    if (s <= kNaiveThreshold) {
+      for (int j = 0; j < s; ++j) {
+        for (int k = 0; k < s; ++k) out[j + k] += x[xa + j] * y[ya + k];
+      }
+      return;
+    }
+    assert(2 * s - 1 <= Mult::dmax() + 1);
+    const std::vector<T> p = Mult::multiply(
+        std::vector<T>(x.begin() + xa, x.begin() + xa + s),
+        std::vector<T>(y.begin() + ya, y.begin() + ya + s));
+    for (int k = 0; k < int(p.size()); ++k) out[k] += p[k];
+  }
+};
@@ -170,33 +170,172 @@ std::optional<std::array<Int, 2>> linear_diophantine(Int a, Int b, Int c) {
   return std::array{x, y};
 }
 
-// Discrete logarithm (Baby-step Giant-step algorithm).
-// Returns the smallest x that satisfies a^x ≡ b (mod m).
-// m is assumed to be a prime number.
-std::optional<int> log_mod(Int a, Int b, const int m) {
-  const int L = ceil_sqrt(m);  // block size
-  a %= m, b %= m;
-
-  // {a^0 => 0, a^1 => 1, ...}
-  std::map<int, int> baby;
-  {
-    int rem = 1;
-    for (long long r = 0; r < L; ++r) {
-      if (not baby.count(rem)) baby[rem] = r;
-      (rem *= a) %= m;
+// Discrete logarithm with a fixed base: the smallest x with a^x ≡ b (mod m).
+// m can be composite, and a does not have to be coprime to m.
+//
+// Write m = m1 * m2, where m1 consists of the primes dividing a. Then
+// a^x ≡ 0 (mod m1) for x >= c (c <= log2 m), so small x are checked
+// directly and the rest is a discrete log in (Z/m2)^*. There, the order of a
+// is split by Pohlig-Hellman, and each prime-order subgroup is solved by BSGS
+// with a flat hash table. The tables are built once and shared by queries.
+//
+// Build: O(sqrt m) (trial division). Query: O(sum_{q^e || ord(a)} e sqrt q).
+class DiscreteLog {
+  using u32 = unsigned;
+  using u64 = unsigned long long;
+
+  // Open addressing with linear probing. Keys are < m < 2^31.
+  struct BabySteps {
+    static constexpr u32 kEmpty = -1;
+    std::vector<u32> keys, vals;
+    int shift;
+
+    explicit BabySteps(int n) {
+      int bits = 1;
+      while ((1 << bits) < 2 * n) ++bits;
+      shift = 64 - bits;
+      keys.assign(1 << bits, kEmpty);
+      vals.resize(1 << bits);
+    }
+    u32 slot(u32 key) const { return (key * 0x9E3779B97F4A7C15ULL) >> shift; }
+
+    // Keeps the first (smallest) value for each key.
+    void insert(u32 key, u32 val) {
+      const u32 mask = keys.size() - 1;
+      u32 i = slot(key);
+      for (; keys[i] != kEmpty; i = (i + 1) & mask) {
+        if (keys[i] == key) return;
+      }
+      keys[i] = key;
+      vals[i] = val;
+    }
+    int find(u32 key) const {
+      const u32 mask = keys.size() - 1;
+      for (u32 i = slot(key); keys[i] != kEmpty; i = (i + 1) & mask) {
+        if (keys[i] == key) return vals[i];
+      }
+      return -1;
+    }
+  };
+
+  // Subgroup of order q^e in <a>, with BSGS over gamma = a^(ord/q).
+  struct Component {
+    Int q, qe;
+    int e;
+    int L;       // baby steps: gamma^0, ..., gamma^{L-1}
+    Int giant;   // gamma^{-L}
+    BabySteps baby;
+  };
+
+  Int a_, m_, m2_, ord_;
+  Int a_inv_;  // mod m2
+  int c_;      // a^x ≡ 0 (mod m / m2) for x >= c_
+  std::vector<Component> comps_;
+
+  Int mul(Int x, Int y, Int m) const { return u64(x) * y % m; }
+  Int pow(Int x, Int t, Int m) const { return atcoder::pow_mod(x, t, m); }
+
+  // The smallest d in [0, q) with gamma^d = h, or -1.
+  Int solve_prime(const Component &comp, Int h) const {
+    for (Int i = 0; i * comp.L < comp.q; ++i) {
+      if (int j = comp.baby.find(h); j >= 0) return i * comp.L + j;
+      h = mul(h, comp.giant, m2_);
     }
+    return -1;
   }
 
-  // Giant step: a^{-L}
-  int step = atcoder::pow_mod(atcoder::inv_mod(a, m), L, m);
-  int giant = b;
-  for (int q = 0; q < L; ++q) {
-    if (auto it = baby.find(giant); it != baby.end()) {
-      return q * L + it->second;
+ public:
+  DiscreteLog(Int a, Int m) : m_(m) {
+    assert(1 <= m and m <= std::numeric_limits<int>::max());
+    a_ = floor_mod(a, m);
+
+    m2_ = m;
+    for (Int g; (g = std::gcd(m2_, a_)) > 1;) m2_ /= g;
+    const Int m1 = m / m2_;
+    c_ = 0;
+    for (Int t = 1 % m1; t != 0; t = mul(t, a_, m1)) ++c_;
+
+    // ord(a) divides phi(m2).
+    Int phi = m2_;
+    {
+      Int x = m2_;
+      for (Int p = 2; p * p <= x; ++p) {
+        if (x % p) continue;
+        phi = phi / p * (p - 1);
+        while (x % p == 0) x /= p;
+      }
+      if (x > 1) phi = phi / x * (x - 1);
+    }
+    std::vector<std::pair<Int, int>> factors;
+    {
+      Int x = phi;
+      for (Int p = 2; p * p <= x; ++p) {
+        if (x % p) continue;
+        factors.emplace_back(p, 0);
+        while (x % p == 0) x /= p, ++factors.back().second;
+      }
+      if (x > 1) factors.emplace_back(x, 1);
+    }
+    ord_ = phi;
+    for (auto &[q, e] : factors) {
+      while (e > 0 and pow(a_, ord_ / q, m2_) == 1 % m2_) ord_ /= q, --e;
+    }
+    a_inv_ = m2_ == 1 ? 0 : atcoder::inv_mod(a_, m2_);
+
+    for (auto [q, e] : factors) {
+      if (e == 0) continue;
+      const Int gamma = pow(a_, ord_ / q, m2_);
+      const int L = ceil_sqrt(q);
+      Component comp{q, 1, e, L, 0, BabySteps(L)};
+      for (int i = 0; i < e; ++i) comp.qe *= q;
+      Int g = 1;
+      for (int j = 0; j < L; ++j) {
+        comp.baby.insert(g, j);
+        g = mul(g, gamma, m2_);
+      }
+      comp.giant = atcoder::inv_mod(g, m2_);
+      comps_.push_back(std::move(comp));
     }
-    (giant *= step) %= m;
   }
-  return std::nullopt;
+
+  // Returns the smallest x >= 0 with a^x ≡ b (mod m).
+  std::optional<Int> operator()(Int b) const {
+    b = floor_mod(b, m_);
+    Int t = 1 % m_;
+    for (int x = 0; x < c_; ++x) {
+      if (t == b) return x;
+      t = mul(t, a_, m_);
+    }
+    if (b % (m_ / m2_) != 0) return std::nullopt;
+
+    // Pohlig-Hellman in (Z/m2)^*.
+    const Int b2 = b % m2_;
+    std::vector<Int> rs, ms;
+    for (const Component &comp : comps_) {
+      Int x = 0, qk = 1;  // x: log mod q^k
+      for (int k = 0; k < comp.e; ++k) {
+        const Int h = pow(mul(b2, pow(a_inv_, x, m2_), m2_),
+                          ord_ / (qk * comp.q), m2_);
+        const Int d = solve_prime(comp, h);
+        if (d < 0) return std::nullopt;
+        x += d * qk;
+        qk *= comp.q;
+      }
+      rs.push_back(x);
+      ms.push_back(comp.qe);
+    }
+    Int x = atcoder::crt(rs, ms).first;
+    // (Z/m2)^* may not be cyclic: b^ord = 1 does not imply b in <a>.
+    if (pow(a_, x, m2_) != b2) return std::nullopt;
+    if (x < c_) x += (c_ - x + ord_ - 1) / ord_ * ord_;
+    return x;
+  }
+};
+
+// Discrete logarithm: the smallest x that satisfies a^x ≡ b (mod m).
+// For many b with the same a and m, use DiscreteLog directly.
+std::optional<Int> log_mod(Int a, Int b, const int m) {
+  return DiscreteLog(a, m)(b);
 }
 
 // verified: https://judge.yosupo.jp/problem/sqrt_mod
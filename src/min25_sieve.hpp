@@ -0,0 +1,126 @@
+// Min_25 sieve: prefix sums of multiplicative functions in O(n^{1-ε}).
+// https://min-25.hatenablog.com/entry/2018/11/11/172216
+//
+// Requires:
+// - FloorValues, lucy_prime_sums (prime_counting.hpp)
+// - LinearSieve (factorization.hpp)
+#include <bits/stdc++.h>
+using Int = long long;
+
+namespace min25_internal {
+
+// Returns sum_{i=1}^{v} i^k.
+// Integral T: closed forms (k <= 2). Otherwise T must be a field (modint),
+// and the degree-(k+1) polynomial is evaluated by Lagrange interpolation.
+template <typename T>
+struct PowerSum {
+  int k;
+  std::vector<T> y;      // y[j] = sum_{i=1}^{j} i^k for j = 0..k+1
+  std::vector<T> denom;  // 1 / prod_{i != j} (j - i)
+
+  explicit PowerSum(int k) : k(k), y(k + 2), denom(k + 2) {
+    if constexpr (is_integral()) {
+      assert(k <= 2);  // v^3 overflows __int128 for v ~ 10^13.
+    } else {
+      for (int j = 1; j <= k + 1; ++j) y[j] = y[j - 1] + T(j).pow(k);
+      for (int j = 0; j <= k + 1; ++j) {
+        T d = 1;
+        for (int i = 0; i <= k + 1; ++i) {
+          if (i != j) d *= T(j - i);
+        }
+        denom[j] = d.inv();
+      }
+    }
+  }
+
+  T operator()(Int v) const {
+    using i128 = __int128;
+    if constexpr (is_integral()) {
+      if (k == 0) return T(v);
+      if (k == 1) return T(i128(v) * (v + 1) / 2);
+      return T(i128(v) * (v + 1) * (2 * v + 1) / 6);
+    } else {
+      if (v <= k + 1) return y[v];
+      const int m = k + 2;
+      std::vector<T> suffix(m + 1);  // prod_{i >= j} (v - i)
+      suffix[m] = 1;
+      for (int i = m - 1; i >= 0; --i) suffix[i] = suffix[i + 1] * T(v - i);
+      T res = 0, prefix = 1;  // prod_{i < j} (v - i)
+      for (int j = 0; j < m; ++j) {
+        res += y[j] * prefix * suffix[j + 1] * denom[j];
+        prefix *= T(v - j);
+      }
+      return res;
+    }
+  }
+
+  static constexpr bool is_integral() {
+    return std::is_integral_v<T> or std::is_same_v<T, __int128>;
+  }
+};
+
+}  // namespace min25_internal
+
+// Returns sum_{i=1}^{n} f(i) for a multiplicative function f given by
+//   f(p) = poly[0] + poly[1] p + poly[2] p^2 + ...  (p: prime)
+//   fpk(p, e, p^e) = f(p^e)  (e >= 1)
+//
+// Examples:
+//   Euler's phi: poly = {-1, 1}, fpk = p^e - p^(e-1)
+//   Divisor count: poly = {2}, fpk = e + 1
+//   Moebius: poly = {-1}, fpk = (e == 1 ? -1 : 0)
+//
+// T: an integral type (deg(poly) <= 2) or a modint.
+// Time: O(n^{3/4} / log n) per term of poly + the second phase; about 2s
+// in total for n = 10^11.
+template <typename T, class FPK>
+T multiplicative_sum(Int n, const std::vector<T> &poly, FPK fpk,
+                     int num_threads = 1) {
+  if (n <= 0) return 0;
+  const FloorValues fv(n);
+  const int m = fv.size();
+
+  // G[i] = sum_{prime p <= values[i]} f(p)
+  std::vector<T> G(m, T(0));
+  for (int k = 0; k < int(poly.size()); ++k) {
+    if (poly[k] == T(0)) continue;
+    const min25_internal::PowerSum<T> psum(k);
+    const auto g = lucy_prime_sums<T>(
+        fv, [&](Int v) { return psum(v) - T(1); },
+        [&](Int p) {
+          T x = 1;
+          for (int i = 0; i < k; ++i) x *= T(p);
+          return x;
+        },
+        num_threads);
+    for (int i = 0; i < m; ++i) G[i] += poly[k] * g[i];
+  }
+
+  const std::vector<int> primes = LinearSieve(fv.sq).primes;
+  const int np = primes.size();
+  // fprefix[j] = sum_{i < j} f(primes[i])
+  std::vector<T> fprefix(np + 1, T(0));
+  for (int j = 0; j < np; ++j) {
+    T fp = 0, x = 1;
+    for (const T &c : poly) {
+      fp += c * x;
+      x *= T(primes[j]);
+    }
+    fprefix[j + 1] = fprefix[j] + fp;
+  }
+
+  // Sum of f(i) over 2 <= i <= v whose smallest prime factor >= primes[j].
+  auto rec = [&](auto &rec, Int v, int j) -> T {
+    if (j < np and primes[j] > v) return 0;
+    T res = G[fv.index(v)] - fprefix[j];
+    for (int i = j; i < np and Int(primes[i]) * primes[i] <= v; ++i) {
+      const Int p = primes[i];
+      Int pe = p;
+      for (int e = 1; pe * p <= v; ++e, pe *= p) {
+        res += fpk(p, e, pe) * rec(rec, v / pe, i + 1) + fpk(p, e + 1, pe * p);
+      }
+    }
+    return res;
+  };
+  return rec(rec, n, 0) + T(1);  // f(1) = 1
+}
@@ -1,8 +1,7 @@
 #include <bits/stdc++.h>
 // Runtime MOD:
-//   unsigned MOD = 998244353;  // modifiable.
-//   template <unsigned& M> struct ModInt { ... };
-//   using Mint = ModInt<MOD>;
+//   using Mint = DynamicModInt<0>;
+//   Mint::set_mod(1000000007);  // per thread (see DynamicModInt).
 
 template <unsigned M>
 struct ModInt {
@@ -66,16 +65,17 @@ struct ModInt {
   }
 
   ModInt inv() const {
-    static constexpr unsigned kPrecalcSize = 10000;
+    static constexpr unsigned kPrecalcSize = std::min(10000U, M);
     static const std::array<ModInt, kPrecalcSize> *kPrecalc = []() {
       auto *a = new std::array<ModInt, kPrecalcSize>;
-      for (ModInt i = 1; i.val() < kPrecalcSize; i += 1) {
-        (*a)[i.val()] = i.inv_internal();
+      for (unsigned i = 1; i < kPrecalcSize; ++i) {
+        (*a)[i] = ModInt(i).inv_internal();
       }
       return a;
     }();
-    if (_v < kPrecalcSize) return (*kPrecalc)[_v];
-    return inv_internal();
+    const ModInt r = (_v < kPrecalcSize) ? (*kPrecalc)[_v] : inv_internal();
+    assert(r._v != 0);  // _v and M are not coprime.
+    return r;
   }
   ModInt &operator/=(const ModInt &a) { return *this *= a.inv(); }
 
@@ -113,22 +113,430 @@ struct ModInt {
   }
 
  private:
+  // Extended Euclid. Returns 0 if _v is not a unit.
   ModInt inv_internal() const {
-    long long b = 1, a = _v;
-    while (a > 1) {
-      long long q = M / a;
-      a = M - a * q;
-      b = -b * q % M;
+    long long a = _v, b = M, x0 = 1, x1 = 0;
+    while (b) {
+      const long long q = a / b;
+      a -= q * b;
+      std::swap(a, b);
+      x0 -= q * x1;
+      std::swap(x0, x1);
+    }
+    return (a == 1) ? ModInt(x0) : ModInt();
+  }
+
+  unsigned _v;  // raw value
+};
+// Inverts all elements in place with a single modular inverse
+// (Montgomery's trick): O(n) multiplications instead of n inversions.
+// Zeros are left as zeros.
+template <typename Mint>
+void batch_inv(std::vector<Mint> &a) {
+  const int n = a.size();
+  std::vector<Mint> prefix(n + 1);
+  prefix[0] = 1;
+  for (int i = 0; i < n; ++i) {
+    prefix[i + 1] = (a[i].val() == 0) ? prefix[i] : prefix[i] * a[i];
+  }
+  Mint acc = prefix[n].inv();  // = 1 / (a[0] * a[1] * ... * a[n-1])
+  for (int i = n - 1; i >= 0; --i) {
+    if (a[i].val() == 0) continue;
+    const Mint x = a[i];
+    a[i] = acc * prefix[i];
+    acc *= x;
+  }
+}
+
+// Fast modular multiplication by a runtime modulus m (1 <= m < 2^31).
+// https://en.wikipedia.org/wiki/Barrett_reduction
+struct BarrettReduction {
+  unsigned m;
+  unsigned long long im;  // ceil(2^64 / m)
+
+  explicit constexpr BarrettReduction(unsigned m)
+      : m(m), im((unsigned long long)(-1) / m + 1) {}
+
+  constexpr unsigned umod() const { return m; }
+
+  // Returns a * b mod m. Requires a, b < m.
+  constexpr unsigned mul(unsigned a, unsigned b) const {
+    unsigned long long z = a;
+    z *= b;
+    unsigned long long x =
+        (unsigned long long)(((__uint128_t)(z)*im) >> 64);
+    unsigned long long y = x * m;
+    return (unsigned)(z - y + (z < y ? m : 0));
+  }
+};
+
+// ModInt with a modulus chosen at runtime. Multiplication uses Barrett
+// reduction instead of a division.
+//
+// The modulus is thread-local by default: each thread starts with 998244353
+// and can call `set_mod()` independently. With `kThreadLocal = false`, a single
+// modulus (e.g. set once at startup) is shared by all threads.
+// Use different `id`s to hold multiple moduli at the same time.
+//
+//   using Mint = DynamicModInt<0>;
+//   Mint::set_mod(m);
+template <int id, bool kThreadLocal = true>
+struct DynamicModInt {
+  DynamicModInt() : _v{0} {}
+  DynamicModInt(long long val) {
+    const long long m = mod();
+    val %= m;
+    if (val < 0) val += m;
+    _v = (unsigned)val;
+  }
+
+  static void set_mod(unsigned m) {
+    assert(1 <= m and m < (1U << 31));
+    barrett() = BarrettReduction(m);
+  }
+  static int mod() { return (int)barrett().umod(); }
+  static unsigned umod() { return barrett().umod(); }
+  inline unsigned val() const { return _v; }
+
+  DynamicModInt &operator++() {
+    _v++;
+    if (_v == umod()) _v = 0;
+    return *this;
+  }
+  DynamicModInt &operator--() {
+    if (_v == 0) _v = umod();
+    _v--;
+    return *this;
+  }
+  DynamicModInt operator++(int) {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+  DynamicModInt operator--(int) {
+    auto result = *this;
+    --*this;
+    return result;
+  }
+
+  DynamicModInt operator-() const { return DynamicModInt() - *this; }
+
+  DynamicModInt &operator+=(const DynamicModInt &a) {
+    if ((_v += a._v) >= umod()) _v -= umod();
+    return *this;
+  }
+  DynamicModInt &operator-=(const DynamicModInt &a) {
+    if ((_v += umod() - a._v) >= umod()) _v -= umod();
+    return *this;
+  }
+  DynamicModInt &operator*=(const DynamicModInt &a) {
+    _v = barrett().mul(_v, a._v);
+    return *this;
+  }
+  DynamicModInt pow(long long t) const {
+    if (_v == 0) {
+      return 0;  // corner case: 0^0 = ?
+    }
+    if (t < 0) {
+      return this->inv().pow(-t);
+    }
+    DynamicModInt base = *this;
+    DynamicModInt res = 1;
+    while (t) {
+      if (t & 1) res *= base;
+      base *= base;
+      t >>= 1;
+    }
+    return res;
+  }
+
+  DynamicModInt inv() const {
+    // Extended Euclid; works for any modulus as long as _v is a unit.
+    long long a = _v, b = umod(), x0 = 1, x1 = 0;
+    while (b) {
+      const long long q = a / b;
+      a -= q * b;
+      std::swap(a, b);
+      x0 -= q * x1;
+      std::swap(x0, x1);
+    }
+    assert(a == 1);  // _v and the modulus are not coprime.
+    return DynamicModInt(x0);
+  }
+  DynamicModInt &operator/=(const DynamicModInt &a) {
+    return *this *= a.inv();
+  }
+
+  friend DynamicModInt operator+(const DynamicModInt &a,
+                                 const DynamicModInt &b) {
+    DynamicModInt r = a;
+    r += b;
+    return r;
+  }
+  friend DynamicModInt operator-(const DynamicModInt &a,
+                                 const DynamicModInt &b) {
+    DynamicModInt r = a;
+    r -= b;
+    return r;
+  }
+  friend DynamicModInt operator*(const DynamicModInt &a,
+                                 const DynamicModInt &b) {
+    DynamicModInt r = a;
+    r *= b;
+    return r;
+  }
+  friend DynamicModInt operator/(const DynamicModInt &a,
+                                 const DynamicModInt &b) {
+    DynamicModInt r = a;
+    r /= b;
+    return r;
+  }
+  friend bool operator==(const DynamicModInt &a, const DynamicModInt &b) {
+    return a._v == b._v;
+  }
+  friend bool operator!=(const DynamicModInt &a, const DynamicModInt &b) {
+    return a._v != b._v;
+  }
+  friend std::istream &operator>>(std::istream &is, DynamicModInt &a) {
+    long long x;
+    is >> x;
+    a = DynamicModInt(x);
+    return is;
+  }
+  friend std::ostream &operator<<(std::ostream &os, const DynamicModInt &a) {
+    return os << a._v;
+  }
+
+ private:
+  static BarrettReduction &barrett() {
+    if constexpr (kThreadLocal) {
+      static thread_local BarrettReduction bt(998244353);
+      return bt;
+    } else {
+      static BarrettReduction bt(998244353);
+      return bt;
     }
-    assert(a == 1);  // if a = 0, _v and M are not coprime.
-    if (b < 0) b += M;
-    ModInt ret;
-    ret._v = (unsigned)b;
-    return ret;
   }
 
   unsigned _v;  // raw value
 };
+
+// Montgomery multiplication for an odd modulus m < 2^62.
+// Values are kept in Montgomery form: x is represented by x * 2^64 mod m.
+// https://en.wikipedia.org/wiki/Montgomery_modular_multiplication
+struct Montgomery64 {
+  using u64 = unsigned long long;
+  using u128 = __uint128_t;
+
+  u64 m;
+  u64 m_inv;  // m^{-1} mod 2^64
+  u64 r2;     // 2^128 mod m
+
+  explicit constexpr Montgomery64(u64 m)
+      : m(m), m_inv(calc_inv(m)), r2(calc_r2(m)) {}
+
+  constexpr u64 umod() const { return m; }
+
+  // Returns t / 2^64 mod m in [0, m). Requires t < m * 2^64.
+  constexpr u64 reduce(u128 t) const {
+    const u64 q = u64(t) * m_inv;
+    const u64 h = u64((u128(q) * m) >> 64);
+    const u64 hi = u64(t >> 64);
+    return (hi >= h) ? hi - h : hi - h + m;
+  }
+  // Montgomery product: a * b / 2^64 mod m.
+  constexpr u64 mul(u64 a, u64 b) const { return reduce(u128(a) * b); }
+  constexpr u64 add(u64 a, u64 b) const {
+    a += b;
+    return (a >= m) ? a - m : a;
+  }
+  constexpr u64 sub(u64 a, u64 b) const { return (a >= b) ? a - b : a + m - b; }
+
+  // Converts x (< m) into / out of Montgomery form.
+  constexpr u64 to_mont(u64 x) const { return mul(x, r2); }
+  constexpr u64 from_mont(u64 x) const { return reduce(x); }
+
+ private:
+  static constexpr u64 calc_inv(u64 m) {
+    assert(m & 1);
+    u64 x = m;  // correct in the lowest 3 bits.
+    for (int i = 0; i < 5; ++i) x *= 2 - m * x;
+    return x;
+  }
+  static constexpr u64 calc_r2(u64 m) {
+    assert(m < (1ULL << 62));
+    return u64((u128(-1) % m + 1) % m);
+  }
+};
+
+// 64-bit ModInt on Montgomery64.
+// Modulus: provides `static const Montgomery64 &mont()`.
+template <typename Modulus>
+struct MontgomeryModInt64 {
+  using u64 = unsigned long long;
+
+  MontgomeryModInt64() : _v{0} {}
+  MontgomeryModInt64(long long val) {
+    const long long m = mod();
+    val %= m;
+    if (val < 0) val += m;
+    _v = mont().to_mont(val);
+  }
+
+  // Only for a runtime modulus (DynamicModInt64).
+  static void set_mod(u64 m) { Modulus::set_mod(m); }
+  static long long mod() { return mont().umod(); }
+  static u64 umod() { return mont().umod(); }
+  inline u64 val() const { return mont().from_mont(_v); }
+
+  MontgomeryModInt64 &operator++() { return *this += 1; }
+  MontgomeryModInt64 &operator--() { return *this -= 1; }
+  MontgomeryModInt64 operator++(int) {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+  MontgomeryModInt64 operator--(int) {
+    auto result = *this;
+    --*this;
+    return result;
+  }
+
+  MontgomeryModInt64 operator-() const {
+    return MontgomeryModInt64() - *this;
+  }
+
+  MontgomeryModInt64 &operator+=(const MontgomeryModInt64 &a) {
+    _v = mont().add(_v, a._v);
+    return *this;
+  }
+  MontgomeryModInt64 &operator-=(const MontgomeryModInt64 &a) {
+    _v = mont().sub(_v, a._v);
+    return *this;
+  }
+  MontgomeryModInt64 &operator*=(const MontgomeryModInt64 &a) {
+    _v = mont().mul(_v, a._v);
+    return *this;
+  }
+  MontgomeryModInt64 pow(long long t) const {
+    if (_v == 0) {
+      return 0;  // corner case: 0^0 = ?
+    }
+    if (t < 0) {
+      return this->inv().pow(-t);
+    }
+    MontgomeryModInt64 base = *this;
+    MontgomeryModInt64 res = 1;
+    while (t) {
+      if (t & 1) res *= base;
+      base *= base;
+      t >>= 1;
+    }
+    return res;
+  }
+
+  MontgomeryModInt64 inv() const {
+    // Extended Euclid. |x0|, |x1| <= m, so no overflow for m < 2^62.
+    long long a = val(), b = mod(), x0 = 1, x1 = 0;
+    while (b) {
+      const long long q = a / b;
+      a -= q * b;
+      std::swap(a, b);
+      x0 -= q * x1;
+      std::swap(x0, x1);
+    }
+    assert(a == 1);  // _v and the modulus are not coprime.
+    return MontgomeryModInt64(x0);
+  }
+  MontgomeryModInt64 &operator/=(const MontgomeryModInt64 &a) {
+    return *this *= a.inv();
+  }
+
+  friend MontgomeryModInt64 operator+(const MontgomeryModInt64 &a,
+                                      const MontgomeryModInt64 &b) {
+    MontgomeryModInt64 r = a;
+    r += b;
+    return r;
+  }
+  friend MontgomeryModInt64 operator-(const MontgomeryModInt64 &a,
+                                      const MontgomeryModInt64 &b) {
+    MontgomeryModInt64 r = a;
+    r -= b;
+    return r;
+  }
+  friend MontgomeryModInt64 operator*(const MontgomeryModInt64 &a,
+                                      const MontgomeryModInt64 &b) {
+    MontgomeryModInt64 r = a;
+    r *= b;
+    return r;
+  }
+  friend MontgomeryModInt64 operator/(const MontgomeryModInt64 &a,
+                                      const MontgomeryModInt64 &b) {
+    MontgomeryModInt64 r = a;
+    r /= b;
+    return r;
+  }
+  // Montgomery form is a bijection on [0, m), so raw values can be compared.
+  friend bool operator==(const MontgomeryModInt64 &a,
+                         const MontgomeryModInt64 &b) {
+    return a._v == b._v;
+  }
+  friend bool operator!=(const MontgomeryModInt64 &a,
+                         const MontgomeryModInt64 &b) {
+    return a._v != b._v;
+  }
+  friend std::istream &operator>>(std::istream &is, MontgomeryModInt64 &a) {
+    long long x;
+    is >> x;
+    a = MontgomeryModInt64(x);
+    return is;
+  }
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const MontgomeryModInt64 &a) {
+    return os << a.val();
+  }
+
+ private:
+  static const Montgomery64 &mont() { return Modulus::mont(); }
+
+  u64 _v;  // Montgomery form
+};
+
+template <unsigned long long M>
+struct StaticModulus64 {
+  static_assert(M % 2 == 1 and M < (1ULL << 62));
+  static constexpr Montgomery64 kMont{M};
+  static constexpr const Montgomery64 &mont() { return kMont; }
+};
+
+// Same threading model as DynamicModInt.
+template <int id, bool kThreadLocal>
+struct DynamicModulus64 {
+  static void set_mod(unsigned long long m) {
+    assert(m % 2 == 1 and m < (1ULL << 62));
+    mont() = Montgomery64(m);
+  }
+  static Montgomery64 &mont() {
+    if constexpr (kThreadLocal) {
+      static thread_local Montgomery64 mt((1ULL << 61) - 1);
+      return mt;
+    } else {
+      static Montgomery64 mt((1ULL << 61) - 1);
+      return mt;
+    }
+  }
+};
+
+// Odd moduli up to 2^62.
+//   using Mint = ModInt64<(1ULL << 61) - 1>;
+template <unsigned long long M>
+using ModInt64 = MontgomeryModInt64<StaticModulus64<M>>;
+
+//   using Mint = DynamicModInt64<0>;
+//   Mint::set_mod(m);
+template <int id, bool kThreadLocal = true>
+using DynamicModInt64 = MontgomeryModInt64<DynamicModulus64<id, kThreadLocal>>;
+
 // constexpr unsigned MOD = int(1e9) + 7;
 // constexpr unsigned MOD = 998244353;
 // using Mint = ModInt<MOD>;
@@ -0,0 +1,327 @@
+// Number Theoretic Transform on 32-bit Montgomery lanes.
+#include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// NTT modulo a prime p = c * 2^k + 1 < 2^30 given at runtime.
+//
+// Values are u32 in Montgomery form (x * 2^32 mod p) and are kept lazily in
+// [0, 2p); to_mont() / from_mont() convert, load() / store() do it for
+// arrays of modints.
+//   transform(a, n): DIF, natural order in, bit-reversed order out.
+//   inverse(a, n):   DIT, bit-reversed order in, natural order out, times
+//                    1/n (times 1 with scale = false, i.e. n * the inverse).
+//   pointwise(a, b, n): a[i] *= b[i].
+//   transform_shifted(a, n): the upper half of a transform of size 2n.
+//   extend(a, n):    a transform of size n -> the one of size 2n.
+//   halve(a, n, odd): even or odd part, as in Bostan-Mori.
+// Both transforms use radix-4 butterflies (AVX2 when available) with one
+// root table rt[b] = z^rev(b) (z: a primitive 2N-th root) whose prefix of
+// length n/2 serves every size n <= 2N, like DoubleFFT
+// (fast_fourier_transform.hpp). Arrays belong to the caller, so scratch
+// buffers and forward transforms can be reused (e.g. in Newton iterations).
+//
+// The first n/2 values of a transform of size n are the transform of size
+// n/2 of the input reduced mod x^{n/2} - 1.
+struct NTT {
+  using u32 = unsigned;
+  using u64 = unsigned long long;
+
+  u32 mod, mod2;  // p, 2p
+  u32 ninv;       // -p^{-1} mod 2^32
+  u32 r2;         // 2^64 mod p
+  int max_log;    // p = c * 2^max_log + 1
+  u32 root;       // primitive root of p
+
+  // g: a primitive root of p, or 0 to compute it here.
+  explicit NTT(u32 p, u32 g = 0)
+      : mod(p), mod2(2 * p), max_log(__builtin_ctz(p - 1)) {
+    assert(p % 2 == 1 and p < (1u << 30));
+    u32 inv = p;  // p * p = 1 mod 8
+    for (int i = 0; i < 4; ++i) inv *= 2 - p * inv;
+    ninv = -inv;
+    r2 = (-u64(p)) % p;
+    root = g ? g : primitive_root(p);
+    // z[j]: a primitive 2^j-th root with z[j]^2 = z[j-1].
+    z.resize(max_log + 1), iz.resize(max_log + 1);
+    z[max_log] = to_mont(pow_mod(root, (p - 1) >> max_log));
+    iz[max_log] = to_mont(pow_mod(from_mont(z[max_log]), p - 2));
+    for (int j = max_log; j > 0; --j) {
+      z[j - 1] = mul(z[j], z[j]);
+      iz[j - 1] = mul(iz[j], iz[j]);
+    }
+  }
+
+  // Montgomery product a * b / 2^32, in [0, 2p) if a * b < 2^32 p (e.g.
+  // a, b < 2p, or b < p and any a).
+  u32 mul(u32 a, u32 b) const {
+    const u64 x = u64(a) * b;
+    return (x + u64(u32(x) * ninv) * mod) >> 32;
+  }
+  u32 to_mont(u32 x) const { return mul(x, r2); }  // any x
+  u32 from_mont(u32 x) const {
+    const u32 r = mul(x, 1);
+    return r >= mod ? r - mod : r;
+  }
+
+  template <class T>
+  void load(const T *src, int m, u32 *dst, int n) const {
+    for (int i = 0; i < m; ++i) dst[i] = to_mont(src[i].val());
+    std::fill(dst + m, dst + n, 0);
+  }
+  template <class T>
+  void store(const u32 *src, int m, T *dst) const {
+    for (int i = 0; i < m; ++i) dst[i] = T(from_mont(src[i]));
+  }
+
+  static constexpr u32 pow_mod(u64 x, u64 e, u32 m) {
+    u64 r = 1;
+    for (x %= m; e; e >>= 1, x = x * x % m) {
+      if (e & 1) r = r * x % m;
+    }
+    return r;
+  }
+
+  // Smallest primitive root of a prime p; usable in constant expressions.
+  static constexpr u32 primitive_root(u32 p) {
+    for (u32 g = 2;; ++g) {
+      bool ok = true;
+      u32 m = p - 1;
+      for (u32 q = 2; q * q <= m; ++q) {
+        if (m % q) continue;
+        while (m % q == 0) m /= q;
+        if (pow_mod(g, (p - 1) / q, p) == 1) ok = false;
+      }
+      if (m > 1 and pow_mod(g, (p - 1) / m, p) == 1) ok = false;
+      if (ok) return g;
+    }
+  }
+
+  void transform(u32 *a, int n) {
+    assert((n & (n - 1)) == 0 and n <= (1 << max_log));
+    if (n <= 1) return;
+    ensure_roots(n / 2);
+    int len = n >> 1;
+    for (; len >= 2; len >>= 2) {
+      const int h = len >> 1;
+      for (int b = 0, s = 0; s < n; ++b, s += 2 * len) {
+        dif4(a + s, h, rt[b], rt[2 * b], rt[2 * b + 1]);
+      }
+    }
+    if (len == 1) {
+      for (int b = 0; b < n / 2; ++b) {
+        const u32 x = a[2 * b], y = mul(a[2 * b + 1], rt[b]);
+        a[2 * b] = reduce(x + y);
+        a[2 * b + 1] = reduce(x + mod2 - y);
+      }
+    }
+  }
+
+  // a[0, n): coefficients of degree < n. Puts the values which a transform
+  // of size 2n would have at [n, 2n), so that a transform of size 2n can be
+  // extended from one of size n.
+  void transform_shifted(u32 *a, int n) {
+    assert(2 * n <= (1 << max_log));
+    if (n > 1) {
+      ensure_roots(n);
+      // The point at position n + i (size 2n) is c times the one at
+      // position i (size n), where c = rt[n/2].
+      const u32 c = rt[n / 2];
+      u32 w = c;
+      for (int i = 1; i < n; ++i) a[i] = mul(a[i], w), w = mul(w, c);
+    }
+    transform(a, n);
+  }
+
+  // a[0, n): transform of size n of a polynomial of degree < n. Fills
+  // a[n, 2n) so that a[0, 2n) is its transform of size 2n.
+  void extend(u32 *a, int n) {
+    std::copy(a, a + n, a + n);
+    inverse(a + n, n);
+    transform_shifted(a + n, n);
+  }
+
+  // a[0, n): transform of size n of S(x) = S_0(x^2) + x S_1(x^2) (degree
+  // < n). a[0, n/2) <- transform of size n/2 of S_0 (odd = false) or S_1.
+  // Positions 2b and 2b+1 hold S(w) and S(-w) with w = rt[b], and
+  // position b of size n/2 holds the value at w^2.
+  void halve(u32 *a, int n, bool odd) {
+    assert(n >= 2 and (n & (n - 1)) == 0);
+    ensure_roots(n / 2);
+    // Reduced to [0, p) so that mul() by x + y < 4p stays in range.
+    u32 half = to_mont((mod + 1) / 2);
+    if (half >= mod) half -= mod;
+    for (int b = 0; b < n / 2; ++b) {
+      const u32 x = a[2 * b], y = a[2 * b + 1];
+      a[b] = odd ? mul(mul(x + mod2 - y, half), irt[b]) : mul(x + y, half);
+    }
+  }
+
+  void inverse(u32 *a, int n, bool scale = true) {
+    assert((n & (n - 1)) == 0 and n <= (1 << max_log));
+    if (n <= 1) return;
+    ensure_roots(n / 2);
+    int h = 1;
+    if (__builtin_ctz(n) & 1) {
+      for (int b = 0; b < n / 2; ++b) {
+        const u32 x = a[2 * b], y = a[2 * b + 1];
+        a[2 * b] = reduce(x + y);
+        a[2 * b + 1] = mul(x + mod2 - y, irt[b]);
+      }
+      h = 2;
+    }
+    for (; 4 * h <= n; h <<= 2) {
+      for (int b = 0, s = 0; s < n; ++b, s += 4 * h) {
+        idif4(a + s, h, irt[b], irt[2 * b], irt[2 * b + 1]);
+      }
+    }
+    if (scale) {
+      // n^{-1} = (p - (p - 1) / n) mod p, as Montgomery form.
+      const u32 c = to_mont(mod - (mod - 1) / n);
+      int i = 0;
+#ifdef __AVX2__
+      const __m256i C = _mm256_set1_epi32(c);
+      for (; i + 8 <= n; i += 8) {
+        __m256i *p = reinterpret_cast<__m256i *>(a + i);
+        _mm256_storeu_si256(p, mulv(_mm256_loadu_si256(p), C, C));
+      }
+#endif
+      for (; i < n; ++i) a[i] = mul(a[i], c);
+    }
+  }
+
+  void pointwise(u32 *a, const u32 *b, int n) const {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 8 <= n; i += 8) {
+      __m256i *p = reinterpret_cast<__m256i *>(a + i);
+      const __m256i y =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+      _mm256_storeu_si256(
+          p, mulv(_mm256_loadu_si256(p), y, _mm256_srli_epi64(y, 32)));
+    }
+#endif
+    for (; i < n; ++i) a[i] = mul(a[i], b[i]);
+  }
+
+ private:
+  std::vector<u32> z, iz;    // primitive 2^j-th roots and their inverses
+  std::vector<u32> rt, irt;  // rt[b] = z^rev(b), irt[b] = rt[b]^{-1}
+
+  u32 pow_mod(u32 x, u32 e) const { return pow_mod(x, e, mod); }
+
+  u32 reduce(u32 x) const { return x >= mod2 ? x - mod2 : x; }  // x < 4p
+
+  void ensure_roots(int half) {
+    int cur = rt.size();
+    if (cur >= half) return;
+    rt.resize(half), irt.resize(half);
+    if (cur == 0) rt[0] = irt[0] = to_mont(1), cur = 1;
+    // b = 2^t + c: rt[b] = z[t+2] * rt[c]. Stored fully reduced (< p).
+    for (int t = __builtin_ctz(cur); (1 << t) < half; ++t) {
+      for (int c = 0; c < (1 << t); ++c) {
+        const u32 w = mul(z[t + 2], rt[c]), iw = mul(iz[t + 2], irt[c]);
+        rt[(1 << t) + c] = w >= mod ? w - mod : w;
+        irt[(1 << t) + c] = iw >= mod ? iw - mod : iw;
+      }
+    }
+  }
+
+#ifdef __AVX2__
+  // Lane-wise mul(); b_odd holds the odd lanes of b in the even positions.
+  __m256i mulv(__m256i a, __m256i b, __m256i b_odd) const {
+    const __m256i n = _mm256_set1_epi32(ninv), p = _mm256_set1_epi32(mod);
+    const __m256i xe = _mm256_mul_epu32(a, b);
+    const __m256i xo = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b_odd);
+    const __m256i re = _mm256_add_epi64(
+        xe, _mm256_mul_epu32(_mm256_mul_epu32(xe, n), p));
+    const __m256i ro = _mm256_add_epi64(
+        xo, _mm256_mul_epu32(_mm256_mul_epu32(xo, n), p));
+    return _mm256_blend_epi32(_mm256_srli_epi64(re, 32), ro, 0b10101010);
+  }
+  // x < 4p -> [0, 2p)
+  __m256i reducev(__m256i x) const {
+    return _mm256_min_epu32(x, _mm256_sub_epi32(x, _mm256_set1_epi32(mod2)));
+  }
+#endif
+
+  // Two DIF stages on the block of size 4h: x0..x3 at j, j+h, j+2h, j+3h.
+  // The first stage uses w1 = rt[b], the second w2 = rt[2b], w3 = rt[2b+1].
+  void dif4(u32 *a, int h, u32 w1, u32 w2, u32 w3) const {
+    u32 *a0 = a, *a1 = a + h, *a2 = a + 2 * h, *a3 = a + 3 * h;
+    int j = 0;
+#ifdef __AVX2__
+    const __m256i W1 = _mm256_set1_epi32(w1), W2 = _mm256_set1_epi32(w2);
+    const __m256i W3 = _mm256_set1_epi32(w3), M2 = _mm256_set1_epi32(mod2);
+    auto ld = [](u32 *p) {
+      return _mm256_loadu_si256(reinterpret_cast<__m256i *>(p));
+    };
+    auto st = [](u32 *p, __m256i v) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+    };
+    for (; j + 8 <= h; j += 8) {
+      const __m256i x0 = ld(a0 + j), x1 = ld(a1 + j);
+      const __m256i x2 = mulv(ld(a2 + j), W1, W1);
+      const __m256i x3 = mulv(ld(a3 + j), W1, W1);
+      const __m256i b0 = reducev(_mm256_add_epi32(x0, x2));
+      const __m256i b2 =
+          reducev(_mm256_sub_epi32(_mm256_add_epi32(x0, M2), x2));
+      const __m256i b1 = mulv(_mm256_add_epi32(x1, x3), W2, W2);
+      const __m256i b3 =
+          mulv(_mm256_sub_epi32(_mm256_add_epi32(x1, M2), x3), W3, W3);
+      st(a0 + j, reducev(_mm256_add_epi32(b0, b1)));
+      st(a1 + j, reducev(_mm256_sub_epi32(_mm256_add_epi32(b0, M2), b1)));
+      st(a2 + j, reducev(_mm256_add_epi32(b2, b3)));
+      st(a3 + j, reducev(_mm256_sub_epi32(_mm256_add_epi32(b2, M2), b3)));
+    }
+#endif
+    for (; j < h; ++j) {
+      const u32 x0 = a0[j], x1 = a1[j];
+      const u32 x2 = mul(a2[j], w1), x3 = mul(a3[j], w1);
+      const u32 b0 = reduce(x0 + x2), b2 = reduce(x0 + mod2 - x2);
+      const u32 b1 = mul(x1 + x3, w2), b3 = mul(x1 + mod2 - x3, w3);
+      a0[j] = reduce(b0 + b1), a1[j] = reduce(b0 + mod2 - b1);
+      a2[j] = reduce(b2 + b3), a3[j] = reduce(b2 + mod2 - b3);
+    }
+  }
+
+  // Inverse of dif4() (times 4), with inverted roots.
+  void idif4(u32 *a, int h, u32 w1, u32 w2, u32 w3) const {
+    u32 *a0 = a, *a1 = a + h, *a2 = a + 2 * h, *a3 = a + 3 * h;
+    int j = 0;
+#ifdef __AVX2__
+    const __m256i W1 = _mm256_set1_epi32(w1), W2 = _mm256_set1_epi32(w2);
+    const __m256i W3 = _mm256_set1_epi32(w3), M2 = _mm256_set1_epi32(mod2);
+    auto ld = [](u32 *p) {
+      return _mm256_loadu_si256(reinterpret_cast<__m256i *>(p));
+    };
+    auto st = [](u32 *p, __m256i v) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+    };
+    for (; j + 8 <= h; j += 8) {
+      const __m256i y0 = ld(a0 + j), y1 = ld(a1 + j);
+      const __m256i y2 = ld(a2 + j), y3 = ld(a3 + j);
+      const __m256i b0 = reducev(_mm256_add_epi32(y0, y1));
+      const __m256i b1 =
+          mulv(_mm256_sub_epi32(_mm256_add_epi32(y0, M2), y1), W2, W2);
+      const __m256i b2 = reducev(_mm256_add_epi32(y2, y3));
+      const __m256i b3 =
+          mulv(_mm256_sub_epi32(_mm256_add_epi32(y2, M2), y3), W3, W3);
+      st(a0 + j, reducev(_mm256_add_epi32(b0, b2)));
+      st(a1 + j, reducev(_mm256_add_epi32(b1, b3)));
+      st(a2 + j,
+         mulv(_mm256_sub_epi32(_mm256_add_epi32(b0, M2), b2), W1, W1));
+      st(a3 + j,
+         mulv(_mm256_sub_epi32(_mm256_add_epi32(b1, M2), b3), W1, W1));
+    }
+#endif
+    for (; j < h; ++j) {
+      const u32 y0 = a0[j], y1 = a1[j], y2 = a2[j], y3 = a3[j];
+      const u32 b0 = reduce(y0 + y1), b1 = mul(y0 + mod2 - y1, w2);
+      const u32 b2 = reduce(y2 + y3), b3 = mul(y2 + mod2 - y3, w3);
+      a0[j] = reduce(b0 + b2), a1[j] = reduce(b1 + b3);
+      a2[j] = mul(b0 + mod2 - b2, w1), a3[j] = mul(b1 + mod2 - b3, w1);
+    }
+  }
+};
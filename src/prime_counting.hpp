@@ -0,0 +1,123 @@
+// Sublinear prime counting (Lucy_Hedgehog's algorithm).
+// https://projecteuler.net/thread=10;page=5#111677
+#include <bits/stdc++.h>
+using Int = long long;
+
+// Distinct values of floor(n/k) for 1 <= k <= n in descending order,
+// i.e. the `value`s of floor_harmonic_sequence() (intmath.hpp), with O(1)
+// lookup of the index of each value.
+struct FloorValues {
+  Int n;
+  Int sq;                   // floor(sqrt(n))
+  int num_large;            // number of values > sq: n/1, n/2, ..., n/num_large
+  std::vector<Int> values;  // descending
+
+  explicit FloorValues(Int n) : n(n) {
+    assert(n >= 1);
+    sq = std::sqrt((long double)n);
+    while (sq * sq > n) --sq;
+    while ((sq + 1) * (sq + 1) <= n) ++sq;
+    for (Int l = 1; l <= n;) {
+      const Int v = n / l;
+      values.push_back(v);
+      l = n / v + 1;
+    }
+    num_large = size() - sq;
+  }
+
+  int size() const { return values.size(); }
+
+  // Index of v, where v must be floor(n/k) for some k.
+  int index(Int v) const { return v <= sq ? size() - v : n / v - 1; }
+};
+
+// Computes S(v) = sum_{prime p <= v} f(p) for every v in `fv.values`.
+// The result is aligned with `fv.values`.
+//
+// f must be completely multiplicative (e.g. f(i) = 1 or i):
+//   prefix(v) = sum_{i=2}^{v} f(i)
+//   fp(p) = f(p)
+//
+// Time: O(n^{3/4} / log n). Space: O(sqrt n).
+// With num_threads > 1, the updates for each small prime (the bulk of the
+// work) are split across threads.
+template <typename T, class Prefix, class FP>
+std::vector<T> lucy_prime_sums(const FloorValues &fv, Prefix prefix, FP fp,
+                               int num_threads = 1) {
+  using u32 = unsigned;
+  const Int n = fv.n;
+  const int m = fv.size(), K = fv.num_large;
+  const u32 sq = fv.sq;
+  std::vector<T> S(m);
+  for (int i = 0; i < m; ++i) S[i] = prefix(fv.values[i]);
+  std::vector<bool> composite(sq + 1);
+  std::vector<T> buf;  // S[index(v/p)] for the parallel path.
+
+  // Index of floor(values[i] / p).
+  auto child = [&](int i, u32 p) -> int {
+    if (i < K) {
+      const Int j = Int(i + 1) * p;
+      if (j <= K) return j - 1;
+      Int w = (double)n / j;  // = n / j, corrected below.
+      while (w * j > n) --w;
+      while ((w + 1) * j <= n) ++w;
+      return m - w;
+    }
+    return m - u32(fv.values[i]) / p;
+  };
+
+  // Runs f(lo, hi) over [0, len) split across threads.
+  auto parallel_for = [&](int len, auto f) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; ++t) {
+      const int lo = Int(len) * t / num_threads;
+      const int hi = Int(len) * (t + 1) / num_threads;
+      workers.emplace_back([=, &f]() { f(lo, hi); });
+    }
+    for (auto &w : workers) w.join();
+  };
+  constexpr int kParallelThreshold = 1 << 16;
+
+  for (u32 p = 2; p <= sq; ++p) {
+    if (composite[p]) continue;
+    for (Int q = Int(p) * p; q <= sq; q += p) composite[q] = true;
+    const T sp = S[m - (p - 1)];  // sum over primes < p
+    const T fpv = fp(p);
+    // Only values >= p^2 change.
+    const Int p2 = Int(p) * p;
+    const int cnt = (p2 > sq) ? n / p2 : m - p2 + 1;
+    if (num_threads > 1 and cnt >= kParallelThreshold) {
+      // Read all old values first, then write.
+      buf.resize(cnt);
+      parallel_for(cnt, [&](int lo, int hi) {
+        for (int i = lo; i < hi; ++i) buf[i] = S[child(i, p)];
+      });
+      parallel_for(cnt, [&](int lo, int hi) {
+        for (int i = lo; i < hi; ++i) S[i] -= fpv * (buf[i] - sp);
+      });
+    } else {
+      // In descending order, S[child(i, p)] is not updated yet.
+      for (int i = 0; i < cnt; ++i) S[i] -= fpv * (S[child(i, p)] - sp);
+    }
+  }
+  return S;
+}
+
+// Number of primes <= n. O(n^{3/4} / log n).
+Int prime_count(Int n, int num_threads = 1) {
+  if (n < 2) return 0;
+  const FloorValues fv(n);
+  return lucy_prime_sums<Int>(
+      fv, [](Int v) { return v - 1; }, [](Int) { return Int(1); },
+      num_threads)[0];
+}
+
+// Sum of primes <= n. O(n^{3/4} / log n).
+__int128 prime_sum(Int n, int num_threads = 1) {
+  using i128 = __int128;
+  if (n < 2) return 0;
+  const FloorValues fv(n);
+  return lucy_prime_sums<i128>(
+      fv, [](Int v) { return i128(v) * (v + 1) / 2 - 1; },
+      [](Int p) { return i128(p); }, num_threads)[0];
+}
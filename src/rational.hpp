@@ -211,3 +211,22 @@ std::istream &operator>>(std::istream &is, Rat &x) {
   x = Rat(nume * sgn, deno);
   return is;
 }
+
+// Converts rationals into modular values, e.g. probabilities given as
+// fractions. Uses batch_inv() (modint.hpp): one modular inverse in total.
+// Include modint.hpp before this file: batch_inv() is a global template,
+// which argument-dependent lookup does not find for atcoder modints.
+template <typename Mint>
+std::vector<Mint> to_modint(const std::vector<Rat> &xs) {
+  const int n = xs.size();
+  std::vector<Mint> res(n);
+  for (int i = 0; i < n; ++i) {
+    res[i] = Mint(xs[i].denominator());
+    assert(res[i].val() != 0);  // The denominator must be invertible.
+  }
+  batch_inv(res);
+  for (int i = 0; i < n; ++i) {
+    res[i] *= Mint(xs[i].numerator());
+  }
+  return res;
+}
@@ -1,94 +1,480 @@
 // In-place Fast Zeta Transform and Fast Moebius Transform.
+//
+// Functions with `num_threads` run on worker threads. With DynamicModInt,
+// use the shared modulus (DynamicModInt<id, false>) in that case, since the
+// default one is thread-local.
+#include <algorithm>
 #include <cassert>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
-// g(S) = sum_{T ⊂ S} f(T)
-template <typename T>
-void subset_zeta_transform(std::vector<T> &f) {
-  const int n = f.size();
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace zeta_internal {
+
+constexpr int kTileBits = 12;  // low bits are done within 2^12-element tiles
+constexpr int kGroupBits = 6;  // high bits are done 6 at a time
+constexpr int kChunk = 64;     // contiguous run per row in high-bit passes
+
+// Runs f(lo, hi) over [0, len) split across threads.
+template <class F>
+void parallel_for(int len, int num_threads, F f) {
+  if (num_threads <= 1 or len <= 1) {
+    f(0, len);
+    return;
+  }
+  std::vector<std::thread> workers;
+  for (int t = 0; t < num_threads; ++t) {
+    const int lo = (long long)len * t / num_threads;
+    const int hi = (long long)len * (t + 1) / num_threads;
+    workers.emplace_back([=, &f]() { f(lo, hi); });
+  }
+  for (auto &w : workers) w.join();
+}
+
+// Row kernels for butterfly_rows(): apply op(x[k], y[k]) for k < len, where
+// x and y are rows that differ in one bit. radix4() does two bits at once:
+// (x0, x1), (x2, x3), then (x0, x2), (x1, x3), keeping values in registers.
+template <class T, class Op>
+struct ScalarRows {
+  Op op;
+
+  void radix2(T *x, T *y, int len) const {
+    for (int k = 0; k < len; ++k) op(x[k], y[k]);
+  }
+  void radix4(T *x0, T *x1, T *x2, T *x3, int len) const {
+    for (int k = 0; k < len; ++k) {
+      T a = x0[k], b = x1[k], c = x2[k], d = x3[k];
+      op(a, b), op(c, d), op(a, c), op(b, d);
+      x0[k] = a, x1[k] = b, x2[k] = c, x3[k] = d;
+    }
+  }
+};
+
+// Applies the row kernels for every bit b < n, i.e. to every pair
+// (f[j], f[j | b]) with j without b, two bits per step (radix 4).
+// Bits are applied in a cache-friendly order: the low bits within each tile,
+// then the high bits in groups, where 2^kGroupBits rows of kChunk contiguous
+// elements are processed together. Each pass over memory handles several
+// bits, and the rows are contiguous so that the kernels can be vectorized.
+template <class T, class Rows>
+void butterfly_rows(T *f, int n, const Rows &rows, int num_threads = 1) {
   assert((n & (n - 1)) == 0);  // n must be power of 2.
-  for (int i = 1; i < n; i <<= 1) {
-    for (int j = 0; j < n; j++) {
-      if ((j & i) == 0) {
-        f[j | i] += f[j];
+  if (n <= 1) return;
+  const int log_n = __builtin_ctz(n);
+  const int tile_bits = std::min(log_n, kTileBits);
+  const int tile = 1 << tile_bits;
+  parallel_for(n >> tile_bits, num_threads, [&](int lo, int hi) {
+    for (int t = lo; t < hi; ++t) {
+      T *a = f + ((long long)t << tile_bits);
+      for (int w = 1; w < tile; w <<= 2) {
+        if (4 * w > tile) {
+          for (int base = 0; base < tile; base += 2 * w) {
+            rows.radix2(a + base, a + base + w, w);
+          }
+          break;
+        }
+        for (int base = 0; base < tile; base += 4 * w) {
+          T *x = a + base;
+          rows.radix4(x, x + w, x + 2 * w, x + 3 * w, w);
+        }
       }
     }
+  });
+  for (int h = tile_bits; h < log_n; h += kGroupBits) {
+    const int g = std::min(kGroupBits, log_n - h);
+    const int num_rows = 1 << g;
+    const int chunks = (1 << h) / kChunk;
+    parallel_for((n >> (h + g)) * chunks, num_threads, [&](int lo, int hi) {
+      for (int u = lo; u < hi; ++u) {
+        T *a = f + ((long long)(u / chunks) << (h + g)) +
+               (long long)(u % chunks) * kChunk;
+        auto row = [&](int r) { return a + ((long long)r << h); };
+        for (int w = 1; w < num_rows; w <<= 2) {
+          if (4 * w > num_rows) {
+            for (int r = 0; r < w; ++r) rows.radix2(row(r), row(r + w), kChunk);
+            break;
+          }
+          for (int base = 0; base < num_rows; base += 4 * w) {
+            for (int r = base; r < base + w; ++r) {
+              rows.radix4(row(r), row(r + w), row(r + 2 * w), row(r + 3 * w),
+                          kChunk);
+            }
+          }
+        }
+      }
+    });
   }
 }
 
+// Calls op(f[j], f[j | b]) for every bit b < n and every j without b.
+template <class T, class Op>
+void butterfly(T *f, int n, Op op, int num_threads = 1) {
+  butterfly_rows(f, n, ScalarRows<T, Op>{op}, num_threads);
+}
+
+}  // namespace zeta_internal
+
+// g(S) = sum_{T ⊂ S} f(T)
+template <typename T>
+void subset_zeta_transform(std::vector<T> &f, int num_threads = 1) {
+  zeta_internal::butterfly(
+      f.data(), f.size(), [](T &x, T &y) { y += x; }, num_threads);
+}
+
 // f(S) = sum_{T ⊂ S} g(T) * (-1)^|S \ T|
 template <typename T>
-void subset_moebius_transform(std::vector<T> &f) {
-  const int n = f.size();
-  assert((n & (n - 1)) == 0);  // n must be power of 2.
-  for (int i = 1; i < n; i <<= 1) {
-    for (int j = 0; j < n; j++) {
-      if ((j & i) == 0) {
-        f[j | i] -= f[j];
-      }
-    }
-  }
+void subset_moebius_transform(std::vector<T> &f, int num_threads = 1) {
+  zeta_internal::butterfly(
+      f.data(), f.size(), [](T &x, T &y) { y -= x; }, num_threads);
 }
 
 template <typename T>
-std::vector<T> bitwise_or_convolution(std::vector<T> f, std::vector<T> g) {
+std::vector<T> bitwise_or_convolution(std::vector<T> f, std::vector<T> g,
+                                      int num_threads = 1) {
   assert(f.size() == g.size());
-  subset_zeta_transform(f);
-  subset_zeta_transform(g);
+  subset_zeta_transform(f, num_threads);
+  subset_zeta_transform(g, num_threads);
   for (int i = 0; i < int(f.size()); ++i) {
     f[i] *= g[i];
   }
-  subset_moebius_transform(f);
+  subset_moebius_transform(f, num_threads);
   return f;
 }
 
 // g(S) = sum_{T ⊃ S} f(T)
 template <typename T>
-void superset_zeta_transform(std::vector<T> &f) {
-  const int n = f.size();
-  assert((n & (n - 1)) == 0);  // n must be power of 2.
-  for (int i = 1; i < n; i <<= 1) {
-    for (int j = 0; j < n; j++) {
-      if ((j & i) == 0) {
-        f[j] += f[j | i];
-      }
+void superset_zeta_transform(std::vector<T> &f, int num_threads = 1) {
+  zeta_internal::butterfly(
+      f.data(), f.size(), [](T &x, T &y) { x += y; }, num_threads);
+}
+
+// f(S) = sum_{T ⊃ S} g(T) * (-1)^|T \ S|
+template <typename T>
+void superset_moebius_transform(std::vector<T> &f, int num_threads = 1) {
+  zeta_internal::butterfly(
+      f.data(), f.size(), [](T &x, T &y) { x -= y; }, num_threads);
+}
+
+template <typename T>
+std::vector<T> bitwise_and_convolution(std::vector<T> f, std::vector<T> g,
+                                       int num_threads = 1) {
+  assert(f.size() == g.size());
+  superset_zeta_transform(f, num_threads);
+  superset_zeta_transform(g, num_threads);
+  for (int i = 0; i < int(f.size()); ++i) {
+    f[i] *= g[i];
+  }
+  superset_moebius_transform(f, num_threads);
+  return f;
+}
+
+namespace zeta_internal {
+
+// 32-bit modints (ModInt, DynamicModInt) stored as the raw value.
+template <class T, class = void>
+struct is_modint32 : std::false_type {};
+template <class T>
+struct is_modint32<T, std::void_t<decltype(T::umod())>>
+    : std::bool_constant<sizeof(T) == 4 and
+                         std::is_trivially_copyable_v<T>> {};
+
+template <class T>
+struct HadamardOp {
+  void operator()(T &x, T &y) const {
+    const T t = x;
+    x += y;
+    y = t - y;
+  }
+};
+
+#ifdef __AVX2__
+// Hadamard row kernels on the raw values of a 32-bit modint (mod < 2^31),
+// 8 lanes at a time. min_epu32 picks the reduced one of s and s -/+ mod.
+template <class T>
+struct HadamardRowsAVX2 {
+  unsigned mod;
+  ScalarRows<T, HadamardOp<T>> scalar;
+
+  static __m256i add(__m256i a, __m256i b, __m256i m) {
+    const __m256i s = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(s, _mm256_sub_epi32(s, m));
+  }
+  static __m256i sub(__m256i a, __m256i b, __m256i m) {
+    const __m256i d = _mm256_sub_epi32(a, b);
+    return _mm256_min_epu32(d, _mm256_add_epi32(d, m));
+  }
+  static __m256i load(const T *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(T *p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+
+  void radix2(T *x, T *y, int len) const {
+    if (len < 8) return scalar.radix2(x, y, len);
+    const __m256i m = _mm256_set1_epi32(mod);
+    for (int k = 0; k < len; k += 8) {
+      const __m256i a = load(x + k), b = load(y + k);
+      store(x + k, add(a, b, m));
+      store(y + k, sub(a, b, m));
     }
   }
+  void radix4(T *x0, T *x1, T *x2, T *x3, int len) const {
+    if (len < 8) return scalar.radix4(x0, x1, x2, x3, len);
+    const __m256i m = _mm256_set1_epi32(mod);
+    for (int k = 0; k < len; k += 8) {
+      const __m256i a = load(x0 + k), b = load(x1 + k);
+      const __m256i c = load(x2 + k), d = load(x3 + k);
+      const __m256i ab = add(a, b, m), a_b = sub(a, b, m);
+      const __m256i cd = add(c, d, m), c_d = sub(c, d, m);
+      store(x0 + k, add(ab, cd, m));
+      store(x1 + k, add(a_b, c_d, m));
+      store(x2 + k, sub(ab, cd, m));
+      store(x3 + k, sub(a_b, c_d, m));
+    }
+  }
+};
+#endif
+
+}  // namespace zeta_internal
+
+// Walsh-Hadamard transform (unnormalized, in place):
+//   g(S) = sum_T (-1)^|S ∩ T| f(T)
+// Applying it twice multiplies by n = f.size().
+// T: a modint, an integer or a floating point type. For 32-bit modints,
+// AVX2 kernels are used when compiled with AVX2 (see gcc_pragma.hpp);
+// the others rely on auto-vectorization of the radix-4 row kernels.
+template <typename T>
+void walsh_hadamard_transform(std::vector<T> &f, int num_threads = 1) {
+#ifdef __AVX2__
+  if constexpr (zeta_internal::is_modint32<T>::value) {
+    if (T::umod() < (1U << 31)) {
+      const zeta_internal::HadamardRowsAVX2<T> rows{T::umod(), {}};
+      zeta_internal::butterfly_rows(f.data(), f.size(), rows, num_threads);
+      return;
+    }
+  }
+#endif
+  zeta_internal::butterfly(f.data(), f.size(), zeta_internal::HadamardOp<T>{},
+                           num_threads);
 }
 
-// f(S) = sum_{T ⊃ S} g(T) * (-1)^|T \ S|
+// h(k) = sum_{i ^ j = k} f(i) g(j)
 template <typename T>
-void superset_moebius_transform(std::vector<T> &f) {
+std::vector<T> bitwise_xor_convolution(std::vector<T> f, std::vector<T> g,
+                                       int num_threads = 1) {
+  assert(f.size() == g.size());
   const int n = f.size();
-  assert((n & (n - 1)) == 0);  // n must be power of 2.
-  for (int i = 1; i < n; i <<= 1) {
-    for (int j = 0; j < n; j++) {
-      if ((j & i) == 0) {
-        f[j] -= f[j | i];
+  walsh_hadamard_transform(f, num_threads);
+  walsh_hadamard_transform(g, num_threads);
+  for (int i = 0; i < n; ++i) {
+    f[i] *= g[i];
+  }
+  walsh_hadamard_transform(f, num_threads);
+  if constexpr (std::is_integral_v<T>) {
+    for (auto &x : f) x /= n;
+  } else {
+    const T inv_n = T(1) / T(n);
+    for (auto &x : f) x *= inv_n;
+  }
+  return f;
+}
+
+namespace zeta_internal {
+
+// Ranked zeta transform of f (size 2^n), stored rank-major:
+//   r[k << n | S] = sum_{T ⊂ S, |T| = k} f(T)
+// Each rank is a contiguous slice transformed by butterfly().
+template <typename T>
+std::vector<T> ranked_zeta(const std::vector<T> &f, int n, int num_threads) {
+  const int N = 1 << n;
+  std::vector<T> r(size_t(n + 1) << n);
+  for (int S = 0; S < N; ++S) r[size_t(__builtin_popcount(S)) << n | S] = f[S];
+  for (int k = 0; k <= n; ++k) {
+    butterfly(
+        r.data() + (size_t(k) << n), N, [](T &x, T &y) { y += x; },
+        num_threads);
+  }
+  return r;
+}
+
+// Inverse of ranked_zeta(), keeping rank |S| for each S.
+template <typename T>
+std::vector<T> ranked_moebius(std::vector<T> &r, int n, int num_threads) {
+  const int N = 1 << n;
+  for (int k = 0; k <= n; ++k) {
+    butterfly(
+        r.data() + (size_t(k) << n), N, [](T &x, T &y) { y -= x; },
+        num_threads);
+  }
+  std::vector<T> f(N);
+  for (int S = 0; S < N; ++S) f[S] = r[size_t(__builtin_popcount(S)) << n | S];
+  return f;
+}
+
+constexpr int kRankBlock = 1 << 9;
+
+// For each S, treats a and b as polynomials in the rank and updates
+//   a(S, z) <- a(S, z) * b(S, z) mod z^{n+1}
+// Each block of S is processed for all ranks at once, and the innermost loop
+// runs over contiguous S.
+template <typename T>
+void ranked_multiply(std::vector<T> &a, const std::vector<T> &b, int n,
+                     int num_threads) {
+  const int N = 1 << n, B = std::min(N, kRankBlock);
+  parallel_for(N / B, num_threads, [&](int lo, int hi) {
+    for (int blk = lo; blk < hi; ++blk) {
+      const size_t s0 = size_t(blk) * B;
+      auto A = [&](int k) { return a.data() + (size_t(k) << n) + s0; };
+      auto Bk = [&](int k) { return b.data() + (size_t(k) << n) + s0; };
+      for (int d = n; d >= 0; --d) {  // a[i] (i < d) is not updated yet.
+        T *ad = A(d);
+        const T *b0 = Bk(0);
+        for (int s = 0; s < B; ++s) ad[s] *= b0[s];
+        for (int i = 0; i < d; ++i) {
+          const T *ai = A(i), *bj = Bk(d - i);
+          for (int s = 0; s < B; ++s) ad[s] += ai[s] * bj[s];
+        }
       }
     }
-  }
+  });
+}
+
+// Same as ranked_multiply(), but a(S, z) <- a(S, z) / b(S, z), where
+// b(S, 0) must be 1.
+template <typename T>
+void ranked_divide(std::vector<T> &a, const std::vector<T> &b, int n,
+                   int num_threads) {
+  const int N = 1 << n, B = std::min(N, kRankBlock);
+  parallel_for(N / B, num_threads, [&](int lo, int hi) {
+    for (int blk = lo; blk < hi; ++blk) {
+      const size_t s0 = size_t(blk) * B;
+      auto A = [&](int k) { return a.data() + (size_t(k) << n) + s0; };
+      auto Bk = [&](int k) { return b.data() + (size_t(k) << n) + s0; };
+      for (int d = 1; d <= n; ++d) {  // a[i] (i < d) is already divided.
+        T *ad = A(d);
+        for (int i = 0; i < d; ++i) {
+          const T *ai = A(i), *bj = Bk(d - i);
+          for (int s = 0; s < B; ++s) ad[s] -= ai[s] * bj[s];
+        }
+      }
+    }
+  });
 }
 
+}  // namespace zeta_internal
+
+// Subset convolution: h(S) = sum_{T ⊂ S} f(T) g(S \ T)
+// O(2^n n^2) by the ranked zeta transform.
 template <typename T>
-std::vector<T> bitwise_and_convolution(std::vector<T> f, std::vector<T> g) {
+std::vector<T> subset_convolution(const std::vector<T> &f,
+                                  const std::vector<T> &g,
+                                  int num_threads = 1) {
   assert(f.size() == g.size());
-  superset_zeta_transform(f);
-  superset_zeta_transform(g);
-  for (int i = 0; i < int(f.size()); ++i) {
-    f[i] *= g[i];
+  const int N = f.size();
+  assert(N >= 1 and (N & (N - 1)) == 0);  // N must be power of 2.
+  const int n = __builtin_ctz(N);
+  auto a = zeta_internal::ranked_zeta(f, n, num_threads);
+  const auto b = zeta_internal::ranked_zeta(g, n, num_threads);
+  zeta_internal::ranked_multiply(a, b, n, num_threads);
+  return zeta_internal::ranked_moebius(a, n, num_threads);
+}
+
+// Exponential of a set power series (f(∅) must be 0):
+//   exp(f)(S) = sum over set partitions {S_1, ..., S_k} of S of prod f(S_i)
+// e.g. f(S) = #connected graphs on S => exp(f)(S) = #graphs on S.
+// Built bit by bit: exp(f)(S ∪ {k}) = sum_{T ⊂ S} f(T ∪ {k}) exp(f)(S \ T)
+// for S ⊂ {0, ..., k-1}. O(2^n n^2) and division-free.
+template <typename T>
+std::vector<T> set_power_series_exp(const std::vector<T> &f,
+                                    int num_threads = 1) {
+  const int N = f.size();
+  assert(N >= 1 and (N & (N - 1)) == 0);  // N must be power of 2.
+  assert(f[0] == T(0));
+  std::vector<T> h(N);
+  h[0] = T(1);
+  for (int k = 0; (1 << k) < N; ++k) {
+    const int M = 1 << k;
+    const std::vector<T> lower(h.begin(), h.begin() + M);
+    const std::vector<T> upper(f.begin() + M, f.begin() + 2 * M);
+    const auto c = subset_convolution(upper, lower, num_threads);
+    std::copy(c.begin(), c.end(), h.begin() + M);
+  }
+  return h;
+}
+
+// Logarithm of a set power series (h(∅) must be 1). Inverse of
+// set_power_series_exp(): f(S ∪ {k}) is the subset quotient of
+// h(S ∪ {k}) by h(S). O(2^n n^2) and division-free.
+template <typename T>
+std::vector<T> set_power_series_log(const std::vector<T> &h,
+                                    int num_threads = 1) {
+  const int N = h.size();
+  assert(N >= 1 and (N & (N - 1)) == 0);  // N must be power of 2.
+  assert(h[0] == T(1));
+  std::vector<T> f(N);
+  for (int k = 0; (1 << k) < N; ++k) {
+    const int M = 1 << k;
+    const std::vector<T> lower(h.begin(), h.begin() + M);
+    const std::vector<T> upper(h.begin() + M, h.begin() + 2 * M);
+    auto a = zeta_internal::ranked_zeta(upper, k, num_threads);
+    const auto b = zeta_internal::ranked_zeta(lower, k, num_threads);
+    zeta_internal::ranked_divide(a, b, k, num_threads);
+    const auto c = zeta_internal::ranked_moebius(a, k, num_threads);
+    std::copy(c.begin(), c.end(), f.begin() + M);
   }
-  superset_moebius_transform(f);
   return f;
 }
 
+namespace zeta_internal {
+
+// Primes p with at least this many multiples below n are processed by
+// multiple threads when num_threads > 1, e.g. p = 2 for n >= 2^17.
+constexpr int kChainParallelThreshold = 1 << 16;
+
+// Calls step(f, pos, len) for every chain pos = {m, mp, mp^2, ...} (< n,
+// p ∤ m, len >= 2). Chains are disjoint, so they are split across threads.
+template <class T, class Step>
+void for_each_prime_chain(std::vector<T> &f, int p, int num_threads,
+                          Step step) {
+  const int n = f.size();
+  parallel_for((n - 1) / p, num_threads, [&](int lo, int hi) {
+    int pos[32];
+    for (int m = lo + 1; m <= hi; ++m) {
+      if (m % p == 0) continue;
+      int len = 0;
+      for (long long x = m; x < n; x *= p) pos[len++] = x;
+      step(f.data(), pos, len);
+    }
+  });
+}
+
+template <class T>
+bool use_chains(const std::vector<T> &f, int p, int num_threads) {
+  return num_threads > 1 and int(f.size()) / p >= kChainParallelThreshold;
+}
+
+}  // namespace zeta_internal
+
 // g(n) = sum_{d|n} f(d)
 // O(N log log N)
 template <class T>
-void divisor_zeta_transform(std::vector<T> &f, const std::vector<int> &primes) {
+void divisor_zeta_transform(std::vector<T> &f, const std::vector<int> &primes,
+                            int num_threads = 1) {
   const int n = f.size();
   for (auto p : primes) {
     if (p >= n) break;
+    if (zeta_internal::use_chains(f, p, num_threads)) {
+      zeta_internal::for_each_prime_chain(
+          f, p, num_threads, [](T *a, const int *pos, int len) {
+            for (int i = 1; i < len; ++i) a[pos[i]] += a[pos[i - 1]];
+          });
+      continue;
+    }
     for (int k = 1; k * p < n; ++k) {
       f[k * p] += f[k];
     }
@@ -99,10 +485,18 @@ void divisor_zeta_transform(std::vector<T> &f, const std::vector<int> &primes) {
 // O(N log log N)
 template <class T>
 void divisor_moebius_transform(std::vector<T> &f,
-                               const std::vector<int> &primes) {
+                               const std::vector<int> &primes,
+                               int num_threads = 1) {
   const int n = f.size();
   for (auto p : primes) {
     if (p >= n) break;
+    if (zeta_internal::use_chains(f, p, num_threads)) {
+      zeta_internal::for_each_prime_chain(
+          f, p, num_threads, [](T *a, const int *pos, int len) {
+            for (int i = len - 1; i > 0; --i) a[pos[i]] -= a[pos[i - 1]];
+          });
+      continue;
+    }
     for (int k = (n - 1) / p; k > 0; --k) {
       f[k * p] -= f[k];
     }
@@ -111,25 +505,33 @@ void divisor_moebius_transform(std::vector<T> &f,
 
 template <typename T>
 std::vector<T> lcm_convolution(std::vector<T> f, std::vector<T> g,
-                               const std::vector<int> &primes) {
+                               const std::vector<int> &primes,
+                               int num_threads = 1) {
   assert(f.size() == g.size());
-  divisor_zeta_transform(f, primes);
-  divisor_zeta_transform(g, primes);
+  divisor_zeta_transform(f, primes, num_threads);
+  divisor_zeta_transform(g, primes, num_threads);
   for (int i = 0; i < int(f.size()); ++i) {
     f[i] *= g[i];
   }
-  divisor_moebius_transform(f, primes);
+  divisor_moebius_transform(f, primes, num_threads);
   return f;
 }
 
 // g(n) = sum_{n|k} f(k)
 // O(N log log N)
 template <class T>
-void multiple_zeta_transform(std::vector<T> &f,
-                             const std::vector<int> &primes) {
+void multiple_zeta_transform(std::vector<T> &f, const std::vector<int> &primes,
+                             int num_threads = 1) {
   const int n = f.size();
   for (auto p : primes) {
     if (p >= n) break;
+    if (zeta_internal::use_chains(f, p, num_threads)) {
+      zeta_internal::for_each_prime_chain(
+          f, p, num_threads, [](T *a, const int *pos, int len) {
+            for (int i = len - 1; i > 0; --i) a[pos[i - 1]] += a[pos[i]];
+          });
+      continue;
+    }
     for (int k = (n - 1) / p; k > 0; --k) {
       f[k] += f[k * p];
     }
@@ -140,10 +542,18 @@ void multiple_zeta_transform(std::vector<T> &f,
 // O(N log log N)
 template <class T>
 void multiple_moebius_transform(std::vector<T> &f,
-                                const std::vector<int> &primes) {
+                                const std::vector<int> &primes,
+                                int num_threads = 1) {
   const int n = f.size();
   for (auto p : primes) {
     if (p >= n) break;
+    if (zeta_internal::use_chains(f, p, num_threads)) {
+      zeta_internal::for_each_prime_chain(
+          f, p, num_threads, [](T *a, const int *pos, int len) {
+            for (int i = 1; i < len; ++i) a[pos[i - 1]] -= a[pos[i]];
+          });
+      continue;
+    }
     for (int k = 1; k * p < n; ++k) {
       f[k] -= f[k * p];
     }
@@ -152,13 +562,67 @@ void multiple_moebius_transform(std::vector<T> &f,
 
 template <typename T>
 std::vector<T> gcd_convolution(std::vector<T> f, std::vector<T> g,
-                               const std::vector<int> &primes) {
+                               const std::vector<int> &primes,
+                               int num_threads = 1) {
   assert(f.size() == g.size());
-  multiple_zeta_transform(f, primes);
-  multiple_zeta_transform(g, primes);
+  multiple_zeta_transform(f, primes, num_threads);
+  multiple_zeta_transform(g, primes, num_threads);
   for (int i = 0; i < int(f.size()); ++i) {
     f[i] *= g[i];
   }
-  multiple_moebius_transform(f, primes);
+  multiple_moebius_transform(f, primes, num_threads);
   return f;
 }
+
+// gcd_convolution() / lcm_convolution() against a fixed kernel g.
+// The transformed kernel and the primes below n are kept, and each call
+// transforms only f, in place.
+//   GcdConvolutionPlan<Mint> plan(g, primes);
+//   for (auto &f : fs) plan.apply(f);  // f <- gcd_convolution(f, g)
+template <typename T, bool kLcm = false>
+class GcdConvolutionPlan {
+  std::vector<int> primes_;  // primes < n
+  std::vector<T> kernel_;    // transformed g
+  int num_threads_;
+
+  void zeta(std::vector<T> &f) const {
+    if constexpr (kLcm) {
+      divisor_zeta_transform(f, primes_, num_threads_);
+    } else {
+      multiple_zeta_transform(f, primes_, num_threads_);
+    }
+  }
+  void moebius(std::vector<T> &f) const {
+    if constexpr (kLcm) {
+      divisor_moebius_transform(f, primes_, num_threads_);
+    } else {
+      multiple_moebius_transform(f, primes_, num_threads_);
+    }
+  }
+
+ public:
+  GcdConvolutionPlan(std::vector<T> g, const std::vector<int> &primes,
+                     int num_threads = 1)
+      : kernel_(std::move(g)), num_threads_(num_threads) {
+    const int n = kernel_.size();
+    for (int p : primes) {
+      if (p >= n) break;
+      primes_.push_back(p);
+    }
+    zeta(kernel_);
+  }
+
+  int size() const { return kernel_.size(); }
+
+  void apply(std::vector<T> &f) const {
+    assert(f.size() == kernel_.size());
+    zeta(f);
+    for (int i = 0; i < int(f.size()); ++i) {
+      f[i] *= kernel_[i];
+    }
+    moebius(f);
+  }
+};
+
+template <typename T>
+using LcmConvolutionPlan = GcdConvolutionPlan<T, true>;
@@ -0,0 +1,93 @@
+#include <bits/stdc++.h>
+
+#include <atcoder/convolution>
+#include <atcoder/math>
+#include <atcoder/modint>
+
+#include "../src/number_theoretic_transform.hpp"
+#include "../src/fast_fourier_transform.hpp"
+#include "../src/formal_power_series.hpp"
+#include "../src/bostan_mori.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace {
+
+// Coefficients of P(x)/Q(x) up to x^{n-1}, by long division.
+template <typename T>
+vector<T> naive_series(const vector<T> &P, const vector<T> &Q, int n) {
+  vector<T> res(n);
+  const T q0inv = Q[0].inv();
+  for (int i = 0; i < n; ++i) {
+    T s = i < int(P.size()) ? P[i] : T(0);
+    for (int j = 1; j < int(Q.size()) and j <= i; ++j) s -= Q[j] * res[i - j];
+    res[i] = s * q0inv;
+  }
+  return res;
+}
+
+template <typename T>
+vector<T> random_vector(int n, mt19937_64 &rng) {
+  vector<T> res(n);
+  for (auto &x : res) x = rng();
+  return res;
+}
+
+}  // namespace
+
+// 998244353, and a prime >= 2^29 (NTT::halve() with to_mont(1/2) >= p).
+template <typename T>
+class BostanMoriNTTTest : public ::testing::Test {};
+using ModInts = ::testing::Types<atcoder::modint998244353,
+                                 atcoder::static_modint<1045430273>>;
+TYPED_TEST_SUITE(BostanMoriNTTTest, ModInts);
+
+TYPED_TEST(BostanMoriNTTTest, Batched) {
+  using T = TypeParam;
+  mt19937_64 rng(1);
+  const int N = 300;
+  for (auto [lp, lq] : vector<pair<int, int>>{
+           {1, 1}, {1, 2}, {3, 4}, {16, 17}, {40, 5}, {7, 33}}) {
+    const vector<T> P = random_vector<T>(lp, rng);
+    vector<T> Q = random_vector<T>(lq, rng);
+    if (Q[0] == T(0)) Q[0] = 1;
+    const vector<T> expected = naive_series(P, Q, N);
+    vector<long long> ns = {0, 1, N - 1, 0, 5, 5};
+    for (int i = 0; i < 20; ++i) ns.push_back(rng() % N);
+    const vector<T> res = bostan_mori_ntt(P, Q, ns);
+    ASSERT_EQ(res.size(), ns.size());
+    for (int i = 0; i < int(ns.size()); ++i) {
+      EXPECT_EQ(res[i], expected[ns[i]]) << lp << " " << lq << " " << ns[i];
+      EXPECT_EQ(bostan_mori_ntt(P, Q, ns[i]), expected[ns[i]]);
+    }
+  }
+}
+
+TYPED_TEST(BostanMoriNTTTest, LinearRecurrence) {
+  using T = TypeParam;
+  mt19937_64 rng(2);
+  for (int k : {1, 2, 5, 16}) {
+    const vector<T> a = random_vector<T>(k, rng), c = random_vector<T>(k, rng);
+    vector<T> seq = a;
+    for (int i = k; i < 200; ++i) {
+      T s = 0;
+      for (int j = 0; j < k; ++j) s += c[j] * seq[i - 1 - j];
+      seq.push_back(s);
+    }
+    const vector<long long> ns = {199, 0, 3, 3, 128, k - 1, k};
+    const vector<T> res = linear_recurrence_ntt(a, c, ns);
+    for (int i = 0; i < int(ns.size()); ++i) {
+      EXPECT_EQ(res[i], seq[ns[i]]) << k << " " << ns[i];
+    }
+  }
+}
+
+TEST(BostanMoriNTTTest, LargeN) {
+  // Fibonacci: F(n) for n = 10^18 agrees with the coefficient-domain one.
+  using F = DenseFPS<multiplication::NTTMult<Mint, 64>>;
+  const vector<Mint> a = {0, 1}, c = {1, 1};
+  const long long n = 1'000'000'000'000'000'000LL;
+  EXPECT_EQ(linear_recurrence_ntt(a, c, {n, n - 1})[0],
+            linear_recurrence<F>(a, c, n));
+}
@@ -0,0 +1,48 @@
+#include <bits/stdc++.h>
+
+#include "../src/combination.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(BinomialCoeffTest, AnyModPascal) {
+  const int N = 200;
+  for (unsigned m : {1U, 2U, 360U, 1024U, 720720U, 999983U}) {
+    BinomialCoeffAnyMod binom(m);
+    vector<unsigned> row = {1 % m};  // row n of Pascal's triangle mod m
+    for (int n = 0; n <= N; ++n) {
+      for (int k = -1; k <= n + 1; ++k) {
+        const unsigned expected = (k < 0 or k > n) ? 0 : row[k];
+        ASSERT_EQ(binom(n, k), expected) << m << " " << n << " " << k;
+      }
+      vector<unsigned> next(n + 2);
+      for (int k = 0; k <= n + 1; ++k) {
+        const unsigned long long a = (k <= n) ? row[k] : 0;
+        const unsigned long long b = (k >= 1) ? row[k - 1] : 0;
+        next[k] = (a + b) % m;
+      }
+      row = std::move(next);
+    }
+  }
+}
+
+TEST(BinomialCoeffTest, PrimePowerLargeN) {
+  // Kummer: n + n has one carry in base 2 for n = 2^j, so C(2n, n) = 2 mod 4.
+  BinomialCoeffPrimePower b2(2, 2);
+  for (long long n : {1LL, 1LL << 20, 1LL << 59}) EXPECT_EQ(b2(2 * n, n), 2u);
+  // Lucas: C(n, k) mod 7 is the product of digit-wise binomials.
+  BinomialCoeffPrimePower b7(7, 1);
+  const long long n = 1'000'000'000'000'000'000LL, k = 123'456'789'012LL;
+  unsigned expected = 1;
+  for (long long x = n, y = k; x > 0; x /= 7, y /= 7) {
+    const int a = x % 7, b = y % 7;
+    if (b > a) {
+      expected = 0;
+      break;
+    }
+    int c = 1;
+    for (int i = 0; i < b; ++i) c = c * (a - i) / (i + 1);
+    expected = expected * c % 7;
+  }
+  EXPECT_EQ(b7(n, k), expected);
+}
@@ -0,0 +1,37 @@
+#include <bits/stdc++.h>
+
+#include "../src/factorization.hpp"
+#include "../src/dirichlet_convolution.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(FloorDirichletSeriesTest, AgainstBruteForce) {
+  using FDS = FloorDirichletSeries<Int>;
+  const int N = 1000000;
+  const LinearSieve ls(N);
+  const auto d = divisor_count_table(N);
+  vector<Int> mertens(N + 1), phi_sum(N + 1), d_sum(N + 1);
+  for (int i = 1; i <= N; ++i) {
+    mertens[i] = mertens[i - 1] + ls.mu[i];
+    phi_sum[i] = phi_sum[i - 1] + ls.phi[i];
+    d_sum[i] = d_sum[i - 1] + d[i];
+  }
+  for (Int n : {1, 2, 3, 10, 99, 1000, 123456, 1000000}) {
+    const FDS zeta = FDS::zeta(n);
+    const FDS id(
+        n, [](Int i) { return i; }, [](Int v) { return v * (v + 1) / 2; });
+    const FDS mu = zeta.inv();
+    const FDS phi = id / zeta;
+    const FDS dc = zeta * zeta;
+    // Floor values n/k, above and below K, and a few small v <= K.
+    vector<Int> vs;
+    for (Int k = 1; k <= n; k = n / (n / k) + 1) vs.push_back(n / k);
+    for (Int v = 1; v <= min<Int>(zeta.K, 20); ++v) vs.push_back(v);
+    for (Int v : vs) {
+      EXPECT_EQ(mu.prefix_sum(v), mertens[v]) << n << " " << v;
+      EXPECT_EQ(phi.prefix_sum(v), phi_sum[v]) << n << " " << v;
+      EXPECT_EQ(dc.prefix_sum(v), d_sum[v]) << n << " " << v;
+    }
+  }
+}
@@ -0,0 +1,122 @@
+#include <bits/stdc++.h>
+
+#include "../src/factorization.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(FactorizationTest, IsPrime) {
+  const vector<bool> sieve = prime_sieve(2000);
+  for (Int n = 0; n <= 2000; ++n) {
+    EXPECT_EQ(is_prime(n), sieve[n]) << n;
+  }
+  EXPECT_TRUE(is_prime(998244353));
+  EXPECT_TRUE(is_prime(1000000000000000003LL));
+  EXPECT_TRUE(is_prime(9223372036854775783LL));  // largest prime < 2^63
+  EXPECT_FALSE(is_prime(3215031751LL));          // strong pseudoprime (2,3,5,7)
+  EXPECT_FALSE(is_prime(1000000007LL * 998244353LL));
+}
+
+TEST(FactorizationTest, Factorize) {
+  EXPECT_EQ(factorize(1), (vector<pair<Int, int>>{}));
+  EXPECT_EQ(factorize(360), (vector<pair<Int, int>>{{2, 3}, {3, 2}, {5, 1}}));
+  EXPECT_EQ(factorize(1000000007LL * 998244353LL),
+            (vector<pair<Int, int>>{{998244353, 1}, {1000000007, 1}}));
+  EXPECT_EQ(factorize(4611686014132420609LL),  // (2^31-1)^2
+            (vector<pair<Int, int>>{{2147483647, 2}}));
+  mt19937_64 rng(1);
+  for (int i = 0; i < 200; ++i) {
+    const Int n = rng() % 1000000000 + 1;
+    EXPECT_EQ(factorize(n), factorize_naive(n)) << n;
+  }
+}
+
+TEST(FactorizationTest, Divisors) {
+  EXPECT_EQ(divisors(12), (vector<Int>{1, 2, 3, 4, 6, 12}));
+  EXPECT_EQ(divisors(1), (vector<Int>{1}));
+  EXPECT_EQ(divisors(720720), divisors_naive(720720));
+  EXPECT_EQ(divisors2(720720), divisors(720720));
+  EXPECT_EQ(totient(1000000007LL * 998244353LL),
+            1000000006LL * 998244352LL);
+  EXPECT_EQ(moebius(30), -1);
+  EXPECT_EQ(moebius(12), 0);
+}
+
+TEST(FactorizationTest, SegmentSieve) {
+  auto expanded = [](Int n) {
+    vector<Int> res;
+    for (auto [p, k] : factorize(n)) res.insert(res.end(), k, p);
+    return res;
+  };
+  for (int num_threads : {1, 3}) {
+    const Int L = 1000000000000LL - 50000, R = 1000000000000LL + 50000;
+    SegmentSieve sieve(L, R, 1, num_threads);
+    for (Int n = L; n < R; n += 997) {
+      EXPECT_EQ(sieve.factorize(n), expanded(n)) << n;
+      EXPECT_EQ(sieve.is_prime(n), is_prime(n)) << n;
+    }
+    EXPECT_TRUE(sieve.is_prime(999999999989LL));
+    EXPECT_TRUE(sieve.is_prime(1000000000039LL));
+    EXPECT_FALSE(sieve.is_prime(1000000000000LL));
+  }
+  SegmentSieve small(0, 200);
+  for (Int n = 1; n < 200; ++n) {
+    EXPECT_EQ(small.is_prime(n), is_prime(n)) << n;
+    EXPECT_EQ(small.factorize(n), expanded(n)) << n;
+  }
+}
+
+TEST(FactorizationTest, MultiplicativeTable) {
+  const int n = 3000;
+  const auto d = divisor_count_table(n);
+  const auto sigma = divisor_sigma_table(n);
+  const auto sigma2 = divisor_sigma_table<Int>(n, 2);
+  const PrimeSieve sieve(n);
+  for (int i = 1; i <= n; ++i) {
+    const auto ds = divisors(i);
+    EXPECT_EQ(d[i], int(ds.size())) << i;
+    EXPECT_EQ(sigma[i], sieve.divisor_sum(i)) << i;
+    Int s2 = 0;
+    for (Int x : ds) s2 += x * x;
+    EXPECT_EQ(sigma2[i], s2) << i;
+  }
+  const LinearSieve ls(n);
+  const auto mu = multiplicative_table<int>(
+      n, [](int, int k, int) { return k == 1 ? -1 : 0; });
+  const auto phi = multiplicative_table<int>(
+      n, [](int p, int, int pk) { return pk - pk / p; });
+  for (int i = 1; i <= n; ++i) {
+    EXPECT_EQ(mu[i], ls.mu[i]) << i;
+    EXPECT_EQ(phi[i], ls.phi[i]) << i;
+  }
+}
+
+TEST(FactorizationTest, SegmentedPrimeSieve) {
+  // Numbers covered by one segment (only odd numbers are stored).
+  const Int seg = 2 * SegmentedPrimeSieve::kSegmentBits;
+  const Int N = 3 * seg + 1;
+  const vector<bool> sieve = prime_sieve(N);
+  for (Int n : {0LL, 1LL, 2LL, 3LL, 100LL, seg - 1, seg, seg + 1, N}) {
+    vector<Int> expected;
+    for (Int p = 2; p <= n; ++p) {
+      if (sieve[p]) expected.push_back(p);
+    }
+    for (int num_threads : {1, 3}) {
+      const SegmentedPrimeSieve sps(n, num_threads);
+      EXPECT_EQ(sps.count(), Int(expected.size())) << n << " " << num_threads;
+      vector<Int> primes;
+      sps.for_each([&](Int p) { primes.push_back(p); });
+      EXPECT_EQ(primes, expected) << n << " " << num_threads;
+      vector<vector<Int>> per_thread(num_threads);
+      sps.for_each_parallel(
+          [&](int tid, Int p) { per_thread[tid].push_back(p); });
+      vector<Int> all;
+      for (const auto &v : per_thread) {
+        EXPECT_TRUE(is_sorted(v.begin(), v.end()));
+        all.insert(all.end(), v.begin(), v.end());
+      }
+      sort(all.begin(), all.end());
+      EXPECT_EQ(all, expected) << n << " " << num_threads;
+    }
+  }
+}
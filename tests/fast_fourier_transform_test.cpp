@@ -0,0 +1,81 @@
+#include <bits/stdc++.h>
+
+#include "../src/fast_fourier_transform.hpp"
+#include "../src/number_theoretic_transform.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using i64 = long long;
+
+namespace {
+
+vector<i64> naive_convolution(const vector<i64> &a, const vector<i64> &b) {
+  vector<i64> res(a.size() + b.size() - 1);
+  for (int i = 0; i < int(a.size()); ++i) {
+    for (int j = 0; j < int(b.size()); ++j) res[i + j] += a[i] * b[j];
+  }
+  return res;
+}
+
+// Exact as long as every coefficient is below 998244353.
+vector<i64> ntt_convolution(const vector<i64> &a, const vector<i64> &b) {
+  static NTT ntt(998244353, 3);
+  const int m = a.size() + b.size() - 1;
+  int n = 1;
+  while (n < m) n *= 2;
+  vector<NTT::u32> fa(n), fb(n);
+  for (int i = 0; i < int(a.size()); ++i) fa[i] = ntt.to_mont(a[i]);
+  for (int i = 0; i < int(b.size()); ++i) fb[i] = ntt.to_mont(b[i]);
+  ntt.transform(fa.data(), n);
+  ntt.transform(fb.data(), n);
+  ntt.pointwise(fa.data(), fb.data(), n);
+  ntt.inverse(fa.data(), n);
+  vector<i64> res(m);
+  for (int i = 0; i < m; ++i) res[i] = ntt.from_mont(fa[i]);
+  return res;
+}
+
+void check(DoubleFFT &fft, int la, int lb, int max_value, mt19937 &rng) {
+  vector<i64> a(la), b(lb);
+  for (auto &x : a) x = rng() % (max_value + 1);
+  for (auto &x : b) x = rng() % (max_value + 1);
+  const vector<i64> expected = (i64(la) * lb <= 1000000)
+                                   ? naive_convolution(a, b)
+                                   : ntt_convolution(a, b);
+  const vector<double> res = fft.multiply(vector<double>(a.begin(), a.end()),
+                                          vector<double>(b.begin(), b.end()));
+  ASSERT_EQ(res.size(), expected.size()) << la << " " << lb;
+  for (int i = 0; i < int(res.size()); ++i) {
+    ASSERT_EQ(llround(res[i]), expected[i]) << la << " " << lb << " " << i;
+  }
+}
+
+}  // namespace
+
+TEST(DoubleFFTTest, SmallLengths) {
+  DoubleFFT fft;
+  mt19937 rng(1);
+  for (int la = 1; la <= 40; ++la) {
+    for (int lb = 1; lb <= 40; ++lb) check(fft, la, lb, 1000, rng);
+  }
+}
+
+TEST(DoubleFFTTest, LargeLengths) {
+  DoubleFFT fft;
+  mt19937 rng(2);
+  // Odd and unequal lengths, up to transforms of size 2^18.
+  const vector<pair<int, int>> sizes = {
+      {1, 1000},     {999, 1},          {1023, 1025},
+      {4097, 3},     {65537, 65535},    {100000, 31},
+      {1 << 17, 1 << 17},
+      {(1 << 17) + 1, 1 << 17},
+      {(1 << 18) - 5, 5},
+  };
+  for (auto [la, lb] : sizes) check(fft, la, lb, 10, rng);
+}
+
+TEST(DoubleFFTTest, Empty) {
+  DoubleFFT fft;
+  EXPECT_TRUE(fft.multiply({}, {1.0}).empty());
+  EXPECT_TRUE(fft.multiply({1.0}, {}).empty());
+}
@@ -0,0 +1,246 @@
+#include <bits/stdc++.h>
+
+#include <atcoder/convolution>
+#include <atcoder/math>
+#include <atcoder/modint>
+
+#include "../src/modint.hpp"
+#include "../src/number_theoretic_transform.hpp"
+#include "../src/fast_fourier_transform.hpp"
+#include "../src/formal_power_series.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace multiplication;
+
+namespace {
+
+template <typename T>
+vector<T> random_vector(int n, mt19937_64 &rng) {
+  vector<T> res(n);
+  for (auto &x : res) x = rng();
+  return res;
+}
+
+// x * y mod x^size.
+template <typename T>
+vector<T> naive_multiply(const vector<T> &x, const vector<T> &y, int size) {
+  const int n = min<int>(x.size() + y.size() - 1, size);
+  vector<T> res(n);
+  for (int i = 0; i < int(x.size()) and i < n; ++i) {
+    for (int j = 0; j < int(y.size()) and i + j < n; ++j) {
+      res[i + j] += x[i] * y[j];
+    }
+  }
+  return res;
+}
+
+}  // namespace
+
+TEST(ArbitraryModMultTest, Multiply) {
+  using T = atcoder::modint1000000007;
+  using Mult = ArbitraryModMult<T, 5000>;
+  mt19937_64 rng(1);
+  for (auto [lx, ly] : vector<pair<int, int>>{
+           {1, 1}, {3, 40}, {32, 33}, {33, 33}, {100, 1000}, {2500, 2501},
+           {4000, 3000}}) {
+    const vector<T> x = random_vector<T>(lx, rng);
+    const vector<T> y = random_vector<T>(ly, rng);
+    EXPECT_EQ(Mult::multiply(x, y), naive_multiply(x, y, 5001))
+        << lx << " " << ly;
+    EXPECT_EQ(Mult::multiply(x, x), naive_multiply(x, x, 5001)) << lx;
+  }
+  // The largest coefficients: all p - 1, i.e. n (p - 1)^2 ~ 2^72.
+  const vector<T> big(4096, T(-1));
+  EXPECT_EQ(Mult::multiply(big, big), naive_multiply(big, big, 5001));
+  const vector<T> big2(4096, T(-1));
+  EXPECT_EQ(Mult::multiply(big, big2), naive_multiply(big, big2, 5001));
+}
+
+TEST(ArbitraryModMultTest, Invert) {
+  using T = atcoder::modint1000000007;
+  using Mult = ArbitraryModMult<T, 3000>;
+  mt19937_64 rng(2);
+  for (int n : {1, 2, 5, 64, 100, 3001}) {
+    vector<T> x = random_vector<T>(n, rng);
+    if (x[0] == T(0)) x[0] = 1;
+    for (int sz : {1, 2, 7, 1000, 3001}) {
+      const vector<T> y = Mult::invert(x, sz);
+      ASSERT_EQ(int(y.size()), sz);
+      vector<T> one = naive_multiply(x, y, sz);
+      one.resize(sz);
+      for (int i = 0; i < sz; ++i) {
+        ASSERT_EQ(one[i], T(i == 0 ? 1 : 0)) << n << " " << sz << " " << i;
+      }
+    }
+    EXPECT_EQ(int(Mult::invert(x).size()), 3001);
+  }
+}
+
+TEST(DynamicNTTMultTest, MultiplyInvert) {
+  using T = DynamicModInt<0>;
+  using Mult = DynamicNTTMult<T, 2000>;
+  mt19937_64 rng(3);
+  // Switching moduli rebuilds the NTT engine.
+  for (unsigned p : {998244353U, 167772161U, 1045430273U, 998244353U}) {
+    T::set_mod(p);
+    for (auto [lx, ly] : vector<pair<int, int>>{
+             {1, 1}, {2, 3}, {64, 65}, {1000, 1001}, {1500, 1700}}) {
+      const vector<T> x = random_vector<T>(lx, rng);
+      const vector<T> y = random_vector<T>(ly, rng);
+      EXPECT_EQ(Mult::multiply(x, y), naive_multiply(x, y, 2001))
+          << p << " " << lx << " " << ly;
+    }
+    vector<T> x = random_vector<T>(700, rng);
+    if (x[0] == T(0)) x[0] = 1;
+    for (int sz : {1, 5, 700, 2001}) {
+      vector<T> one = naive_multiply(x, Mult::invert(x, sz), sz);
+      one.resize(sz);
+      for (int i = 0; i < sz; ++i) {
+        ASSERT_EQ(one[i], T(i == 0 ? 1 : 0)) << p << " " << sz << " " << i;
+      }
+    }
+  }
+}
+
+TEST(NTTMultTest, OtherPrimes) {
+  using T = atcoder::static_modint<469762049>;
+  using Mult = NTTMult<T, 3000>;
+  mt19937_64 rng(4);
+  const vector<T> x = random_vector<T>(1234, rng);
+  const vector<T> y = random_vector<T>(2345, rng);
+  EXPECT_EQ(Mult::multiply(x, y), naive_multiply(x, y, 3001));
+}
+
+TEST(RelaxedConvolutionTest, AgainstOffline) {
+  using Mult = NTTMult<Mint, 1 << 12>;
+  mt19937_64 rng(5);
+  const int n = 3000;  // blocks up to 1024 go through Mult::multiply
+  const vector<Mint> f = random_vector<Mint>(n, rng);
+  const vector<Mint> g = random_vector<Mint>(n, rng);
+  const vector<Mint> h = Mult::multiply(f, g);
+  RelaxedConvolution<Mult> rc;
+  for (int i = 0; i < n; ++i) {
+    ASSERT_EQ(rc.push(f[i], g[i]), h[i]) << i;
+  }
+  EXPECT_EQ(rc.size(), n);
+}
+
+TEST(RelaxedConvolutionTest, Catalan) {
+  // C_{i+1} = sum_{j <= i} C_j C_{i-j}: h_i is needed for f_{i+1}.
+  const int n = 2500;
+  RelaxedConvolution<NTTMult<Mint, 1 << 12>> rc;
+  vector<Mint> c = {1};
+  for (int i = 0; i < n; ++i) c.push_back(rc.push(c[i], c[i]));
+  Mint binom = 1;  // C(2i, i)
+  for (int i = 0; i <= n; ++i) {
+    ASSERT_EQ(c[i], binom / (i + 1)) << i;
+    binom *= Mint(2 * i + 1) * (2 * i + 2) / ((i + 1) * (i + 1));
+  }
+}
+
+TEST(SubproductTreeTest, EvaluateInterpolate) {
+  using F = DenseFPS<NTTMult<Mint, 1 << 13>>;
+  mt19937_64 rng(6);
+  for (int n : {1, 2, 3, 5, 16, 17, 64, 65, 1024, 1025}) {
+    // Distinct points, including 0.
+    set<unsigned> seen = {0};
+    vector<Mint> a = {0};
+    while (int(a.size()) < n) {
+      const unsigned v = rng() % Mint::mod();
+      if (seen.insert(v).second) a.push_back(v);
+    }
+    shuffle(a.begin(), a.end(), rng);
+    for (int deg : {0, n - 1, n, 3 * n + 2}) {
+      const F f(random_vector<Mint>(deg + 1, rng));
+      const vector<Mint> v = multipoint_eval(f, a);
+      ASSERT_EQ(int(v.size()), n);
+      for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(v[i], eval(f, a[i])) << n << " " << deg << " " << i;
+      }
+      if (deg >= n) continue;
+      // Round trip: deg f < n is recovered from its values.
+      vector<Mint> p = interpolate<F>(a, v).coeff;
+      p.resize(deg + 1);
+      EXPECT_EQ(p, f.coeff) << n << " " << deg;
+    }
+    // Random values: the interpolant has degree < n and passes through them.
+    const vector<Mint> y = random_vector<Mint>(n, rng);
+    const F p = interpolate<F>(a, y);
+    EXPECT_LE(p.size(), n);
+    EXPECT_EQ(multipoint_eval(p, a), y) << n;
+  }
+  // Repeated points are fine for evaluation.
+  const F f(random_vector<Mint>(10, rng));
+  const vector<Mint> a = {3, 3, 0, 3, 7};
+  const vector<Mint> v = multipoint_eval(f, a);
+  for (int i = 0; i < int(a.size()); ++i) EXPECT_EQ(v[i], eval(f, a[i]));
+}
+
+TEST(TaylorShiftTest, AgainstEval) {
+  using F = DenseFPS<NTTMult<Mint, 1 << 12>>;
+  mt19937_64 rng(7);
+  for (int n : {1, 2, 3, 16, 17, 1000}) {
+    const F f(random_vector<Mint>(n, rng));
+    for (Mint c : {Mint(0), Mint(1), -Mint(1), Mint(rng())}) {
+      const F g = taylor_shift(f, c);
+      ASSERT_EQ(g.size(), n);
+      for (int t = 0; t < 5; ++t) {
+        const Mint x = rng();
+        EXPECT_EQ(eval(g, x), eval(f, x + c)) << n << " " << c.val();
+      }
+    }
+  }
+}
+
+TEST(CompositionTest, AgainstHorner) {
+  using F = DenseFPS<NTTMult<Mint, 1 << 12>>;
+  // f(g) mod x^n by Horner: (...(f_{m-1} g + f_{m-2}) g + ...) + f_0.
+  auto horner = [](const vector<Mint> &f, const vector<Mint> &g, int n) {
+    vector<Mint> res(n);
+    for (int i = int(f.size()) - 1; i >= 0; --i) {
+      res = naive_multiply(res, g, n);
+      res[0] += f[i];
+    }
+    return res;
+  };
+  mt19937_64 rng(8);
+  for (auto [m, n] : vector<pair<int, int>>{{1, 1},  {1, 5},  {2, 1},
+                                            {5, 1},  {3, 3},  {7, 20},
+                                            {40, 9}, {33, 33}, {64, 65},
+                                            {100, 17}, {17, 100}}) {
+    for (int g0_zero = 0; g0_zero < 2; ++g0_zero) {
+      for (int lg : {1, 2, n, n + 3}) {
+        const vector<Mint> f = random_vector<Mint>(m, rng);
+        vector<Mint> g = random_vector<Mint>(lg, rng);
+        if (g0_zero) g[0] = 0;
+        vector<Mint> res = composition(F(f), F(g), n).coeff;
+        res.resize(n);
+        EXPECT_EQ(res, horner(f, g, n))
+            << m << " " << n << " " << g0_zero << " " << lg;
+      }
+    }
+  }
+}
+
+TEST(CompositionTest, Timing) {
+  // Prints timings. Sizes are kept small for the sanitizer build; expect
+  // roughly 4.5x per 4x in n for composition (O(n log^2 n)).
+  using F = DenseFPS<NTTMult<Mint, 1 << 14>>;
+  mt19937_64 rng(9);
+  for (int n : {1 << 10, 1 << 12, 1 << 14}) {
+    const F f(random_vector<Mint>(n, rng)), g(random_vector<Mint>(n, rng));
+    auto t0 = chrono::steady_clock::now();
+    const F h = taylor_shift(f, Mint(rng()));
+    auto t1 = chrono::steady_clock::now();
+    const F k = composition(f, g, n);
+    auto t2 = chrono::steady_clock::now();
+    auto ms = [](auto d) {
+      return chrono::duration_cast<chrono::milliseconds>(d).count();
+    };
+    cerr << "n = " << n << ": taylor_shift " << ms(t1 - t0)
+         << " ms, composition " << ms(t2 - t1) << " ms" << endl;
+    EXPECT_EQ(h.size(), n);
+    EXPECT_EQ(k.size(), n);
+  }
+}
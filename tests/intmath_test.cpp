@@ -0,0 +1,57 @@
+#include <bits/stdc++.h>
+
+#include <atcoder/math>
+
+#include "../src/intmath.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(DiscreteLogTest, BruteForce) {
+  for (int m = 1; m <= 300; ++m) {
+    for (int a = 0; a < m; ++a) {
+      // first[b]: the smallest x with a^x = b, found by walking a^x.
+      // The sequence is periodic after at most m steps.
+      vector<Int> first(m, -1);
+      Int t = 1 % m;
+      for (int x = 0; x <= 2 * m; ++x) {
+        if (first[t] < 0) first[t] = x;
+        t = t * a % m;
+      }
+      const DiscreteLog dlog(a, m);
+      for (int b = 0; b < m; ++b) {
+        const optional<Int> res = dlog(b);
+        const Int got = res.has_value() ? *res : -1;
+        if (got != first[b]) {
+          ADD_FAILURE() << a << "^x = " << b << " mod " << m << ": " << got
+                        << " != " << first[b];
+        }
+      }
+    }
+  }
+}
+
+TEST(DiscreteLogTest, LargeModuli) {
+  mt19937_64 rng(1);
+  // Primes, prime powers, and composites with a not coprime to m.
+  const vector<pair<Int, int>> cases = {
+      {3, 998244353},     {7, 2147483647}, {5, 1000000007},
+      {3, 1000000000},    {2, 1000000000}, {6, 1 << 30},
+      {12345, 2147483646}, {10, 1999999874},
+  };
+  for (auto [a, m] : cases) {
+    const DiscreteLog dlog(a, m);
+    for (int i = 0; i < 20; ++i) {
+      const Int x = rng() % (i < 10 ? 40 : m);
+      const Int b = atcoder::pow_mod(a, x, m);
+      const optional<Int> res = dlog(b);
+      ASSERT_TRUE(res.has_value()) << a << " " << m << " " << x;
+      EXPECT_EQ(atcoder::pow_mod(a, *res, m), b) << a << " " << m;
+      EXPECT_LE(*res, x);
+      EXPECT_EQ(log_mod(a, b, m), res);
+    }
+  }
+  EXPECT_EQ(log_mod(2, 1 << 20, 1000000007), 20);
+  EXPECT_EQ(log_mod(2, 3, 4), nullopt);
+  EXPECT_EQ(log_mod(2, 3, 7), nullopt);  // <2> = {1, 2, 4}
+}
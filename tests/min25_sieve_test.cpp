@@ -0,0 +1,59 @@
+#include <bits/stdc++.h>
+
+#include "../src/modint.hpp"
+#include "../src/factorization.hpp"
+#include "../src/prime_counting.hpp"
+#include "../src/min25_sieve.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(Min25SieveTest, AgainstLinearSieve) {
+  const int N = 100000;
+  const LinearSieve ls(N);
+  const auto d = divisor_count_table(N);
+  vector<Int> phi_sum(N + 1), mu_sum(N + 1), d_sum(N + 1);
+  for (int i = 1; i <= N; ++i) {
+    phi_sum[i] = phi_sum[i - 1] + ls.phi[i];
+    mu_sum[i] = mu_sum[i - 1] + ls.mu[i];
+    d_sum[i] = d_sum[i - 1] + d[i];
+  }
+  auto phi = [](Int p, int, Int pe) { return pe - pe / p; };
+  auto mu = [](Int, int e, Int) { return e == 1 ? Int(-1) : Int(0); };
+  auto dc = [](Int, int e, Int) { return Int(e + 1); };
+  for (Int n : {1, 2, 3, 4, 10, 97, 1000, 65536, 99991, 100000}) {
+    for (int num_threads : {1, 2}) {
+      EXPECT_EQ(multiplicative_sum<Int>(n, {-1, 1}, phi, num_threads),
+                phi_sum[n])
+          << n;
+      EXPECT_EQ(multiplicative_sum<Int>(n, {-1}, mu, num_threads), mu_sum[n])
+          << n;
+      EXPECT_EQ(multiplicative_sum<Int>(n, {2}, dc, num_threads), d_sum[n])
+          << n;
+    }
+  }
+}
+
+TEST(Min25SieveTest, Modint) {
+  // sum of sigma_3(i) = sum of i^3 over divisors: f(p) = 1 + p^3, which
+  // takes the Lagrange interpolation path of PowerSum.
+  using Mint = ModInt<998244353>;
+  const int N = 3000;
+  vector<Mint> sigma3(N + 1);
+  for (int d = 1; d <= N; ++d) {
+    for (int i = d; i <= N; i += d) sigma3[i] += Mint(d).pow(3);
+  }
+  auto fpk = [](Int p, int e, Int) {
+    Mint s = 0, q = 1;
+    for (int i = 0; i <= e; ++i, q *= Mint(p).pow(3)) s += q;
+    return s;
+  };
+  Mint expected = 0;
+  for (int n = 1; n <= N; ++n) {
+    expected += sigma3[n];
+    if (n % 97 == 1 or n == N) {
+      EXPECT_EQ(multiplicative_sum<Mint>(n, {1, 0, 0, 1}, fpk), expected)
+          << n;
+    }
+  }
+}
@@ -34,4 +34,132 @@ TEST(ModIntTest, InvModNonPrime) {
   auto b = a.inv();
   EXPECT_EQ((a * b).val(), 1);
   EXPECT_EQ(b.val(), 5);
+  EXPECT_DEBUG_DEATH(ModInt<6>(4).inv(), "");
+  EXPECT_EQ(ModInt<20000>(1).inv().val(), 1);
+  EXPECT_EQ((ModInt<20000>(10001) * ModInt<20000>(10001).inv()).val(), 1);
+  EXPECT_EQ((ModInt<20000>(3) * ModInt<20000>(3).inv()).val(), 1);
+  EXPECT_DEBUG_DEATH(ModInt<20000>(10002).inv(), "");
+  EXPECT_DEBUG_DEATH(ModInt<20000>(5).inv(), "");
+  using M9 = ModInt<1000000000>;
+  for (long long x : {3LL, 7LL, 9999LL, 123456789LL, 999999999LL}) {
+    EXPECT_EQ((M9(x) * M9(x).inv()).val(), 1) << x;
+  }
+}
+
+TEST(DynamicModIntTest, Arithmetic) {
+  using Mint = DynamicModInt<1>;
+  Mint::set_mod(1000000007);
+  EXPECT_EQ(Mint::mod(), 1000000007);
+  Mint a = -1;
+  EXPECT_EQ(a.val(), 1000000006);
+  EXPECT_EQ((a * a).val(), 1);
+  EXPECT_EQ((a + 2).val(), 1);
+  EXPECT_EQ(Mint(2).pow(30).val(), 73741817);
+  Mint b = 123456789;
+  EXPECT_EQ((b * b.inv()).val(), 1);
+  EXPECT_EQ((b / b).val(), 1);
+
+  // Compare against plain division for moduli near 2^31.
+  Mint::set_mod(2147483647);
+  mt19937_64 rng(1);
+  for (int i = 0; i < 1000; ++i) {
+    unsigned x = rng() % 2147483647, y = rng() % 2147483647;
+    EXPECT_EQ((Mint(x) * Mint(y)).val(),
+              (unsigned long long)(x)*y % 2147483647);
+  }
+}
+
+TEST(DynamicModIntTest, InvCompositeModulus) {
+  using Mint = DynamicModInt<4>;
+  for (unsigned m : {12U, 1000000000U}) {
+    Mint::set_mod(m);
+    for (unsigned x = 1; x < 20000 and x < m; ++x) {
+      if (gcd(x, m) != 1) continue;
+      EXPECT_EQ((Mint(x) * Mint(x).inv()).val(), 1) << m << " " << x;
+    }
+  }
+  Mint::set_mod(12);
+  EXPECT_EQ(Mint(5).inv().val(), 5);
+  EXPECT_DEBUG_DEATH(Mint(4).inv(), "");
+}
+
+TEST(DynamicModIntTest, ThreadLocalModulus) {
+  using Mint = DynamicModInt<2>;
+  Mint::set_mod(7);
+  unsigned other = 0;
+  std::thread th([&]() {
+    Mint::set_mod(11);
+    other = (Mint(5) * Mint(3)).val();
+  });
+  th.join();
+  EXPECT_EQ(other, 4);
+  EXPECT_EQ(Mint::mod(), 7);
+  EXPECT_EQ((Mint(5) * Mint(3)).val(), 1);
+}
+
+TEST(DynamicModIntTest, SharedModulus) {
+  using Mint = DynamicModInt<3, false>;
+  Mint::set_mod(13);
+  unsigned other = 0;
+  std::thread th([&]() { other = Mint::umod(); });
+  th.join();
+  EXPECT_EQ(other, 13);
+}
+
+TEST(ModIntTest, BatchInv) {
+  using Mint = ModInt<998244353>;
+  vector<Mint> a = {1, 2, 0, 3, 998244352, 123456789};
+  vector<Mint> b = a;
+  batch_inv(b);
+  for (int i = 0; i < (int)a.size(); ++i) {
+    if (a[i].val() == 0) {
+      EXPECT_EQ(b[i].val(), 0);
+    } else {
+      EXPECT_EQ(b[i], a[i].inv());
+    }
+  }
+  vector<Mint> empty;
+  batch_inv(empty);
+  EXPECT_TRUE(empty.empty());
+}
+
+TEST(ModInt64Test, Arithmetic) {
+  constexpr unsigned long long kMod = (1ULL << 61) - 1;
+  using Mint = ModInt64<kMod>;
+  Mint a = -1;
+  EXPECT_EQ(a.val(), kMod - 1);
+  EXPECT_EQ((a * a).val(), 1);
+  EXPECT_EQ((a + 2).val(), 1);
+  EXPECT_EQ((Mint(3) - Mint(5)).val(), kMod - 2);
+  EXPECT_EQ(Mint(2).pow(61).val(), 1);
+  Mint b = 1234567890123456789LL;
+  EXPECT_EQ((b * b.inv()).val(), 1);
+  EXPECT_EQ((b / b).val(), 1);
+  ++b;
+  EXPECT_EQ(b.val(), 1234567890123456790ULL);
+
+  mt19937_64 rng(1);
+  for (int i = 0; i < 1000; ++i) {
+    unsigned long long x = rng() % kMod, y = rng() % kMod;
+    EXPECT_EQ((Mint(x) * Mint(y)).val(),
+              (unsigned long long)((__uint128_t)(x)*y % kMod));
+  }
+}
+
+TEST(ModInt64Test, DynamicModulus) {
+  using Mint = DynamicModInt64<0>;
+  mt19937_64 rng(2);
+  for (int t = 0; t < 100; ++t) {
+    const unsigned long long m = (rng() >> 2) | 1;  // odd, < 2^62
+    Mint::set_mod(m);
+    EXPECT_EQ(Mint::umod(), m);
+    for (int i = 0; i < 20; ++i) {
+      unsigned long long x = rng() % m, y = rng() % m;
+      EXPECT_EQ((Mint(x) * Mint(y)).val(),
+                (unsigned long long)((__uint128_t)(x)*y % m));
+      EXPECT_EQ((Mint(x) + Mint(y)).val(), (x + y) % m);
+    }
+  }
+  Mint::set_mod(7);
+  EXPECT_EQ((Mint(4).inv()).val(), 2);
 }
@@ -0,0 +1,133 @@
+#include <bits/stdc++.h>
+
+#include "../src/number_theoretic_transform.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using u32 = NTT::u32;
+using u64 = NTT::u64;
+
+namespace {
+
+// 998244353 and primes >= 2^29 where to_mont((p + 1) / 2) can exceed p.
+const vector<u32> kPrimes = {998244353, 1045430273, 1051721729, 715128833};
+
+u64 pow_mod(u64 x, u64 e, u64 p) { return NTT::pow_mod(x, e, p); }
+
+vector<u32> random_poly(int n, u32 p, mt19937 &rng) {
+  vector<u32> a(n);
+  for (auto &x : a) x = rng() % p;
+  return a;
+}
+
+// Transform of size n of a, out of Montgomery form.
+vector<u32> transformed(NTT &ntt, const vector<u32> &a, int n) {
+  vector<u32> w(n);
+  for (int i = 0; i < int(a.size()); ++i) w[i] = ntt.to_mont(a[i]);
+  ntt.transform(w.data(), n);
+  for (auto &x : w) x = ntt.from_mont(x);
+  return w;
+}
+
+}  // namespace
+
+TEST(NTTTest, Convolution) {
+  mt19937 rng(1);
+  for (u32 p : kPrimes) {
+    NTT ntt(p);
+    for (int la : {1, 3, 17, 64}) {
+      const vector<u32> a = random_poly(la, p, rng);
+      const vector<u32> b = random_poly(la + 5, p, rng);
+      const int m = a.size() + b.size() - 1;
+      int n = 1;
+      while (n < m) n *= 2;
+      vector<u32> fa(n), fb(n);
+      for (int i = 0; i < int(a.size()); ++i) fa[i] = ntt.to_mont(a[i]);
+      for (int i = 0; i < int(b.size()); ++i) fb[i] = ntt.to_mont(b[i]);
+      ntt.transform(fa.data(), n);
+      ntt.transform(fb.data(), n);
+      ntt.pointwise(fa.data(), fb.data(), n);
+      ntt.inverse(fa.data(), n);
+      for (int k = 0; k < m; ++k) {
+        u64 expected = 0;
+        for (int i = 0; i < int(a.size()); ++i) {
+          if (k - i >= 0 and k - i < int(b.size())) {
+            expected = (expected + u64(a[i]) * b[k - i]) % p;
+          }
+        }
+        EXPECT_EQ(ntt.from_mont(fa[k]), expected) << p << " " << k;
+      }
+    }
+  }
+}
+
+TEST(NTTTest, Extend) {
+  mt19937 rng(2);
+  for (u32 p : kPrimes) {
+    NTT ntt(p);
+    for (int n : {1, 2, 4, 32, 256}) {
+      const vector<u32> a = random_poly(n, p, rng);
+      vector<u32> w(2 * n);
+      for (int i = 0; i < n; ++i) w[i] = ntt.to_mont(a[i]);
+      ntt.transform(w.data(), n);
+      ntt.extend(w.data(), n);
+      for (auto &x : w) x = ntt.from_mont(x);
+      EXPECT_EQ(w, transformed(ntt, a, 2 * n)) << p << " " << n;
+    }
+  }
+}
+
+TEST(NTTTest, Halve) {
+  mt19937 rng(3);
+  for (u32 p : kPrimes) {
+    NTT ntt(p);
+    for (int n : {2, 4, 8, 64, 512}) {
+      const vector<u32> s = random_poly(n, p, rng);
+      for (int odd = 0; odd < 2; ++odd) {
+        vector<u32> part(n / 2);
+        for (int i = 0; i < n / 2; ++i) part[i] = s[2 * i + odd];
+        vector<u32> w(n);
+        for (int i = 0; i < n; ++i) w[i] = ntt.to_mont(s[i]);
+        ntt.transform(w.data(), n);
+        ntt.halve(w.data(), n, odd);
+        w.resize(n / 2);
+        for (auto &x : w) {
+          EXPECT_LT(x, 2 * p);
+          x = ntt.from_mont(x);
+        }
+        EXPECT_EQ(w, transformed(ntt, part, n / 2)) << p << " " << n;
+      }
+    }
+  }
+}
+
+// Inputs anywhere in [0, 2p), including values near 2p.
+TEST(NTTTest, HalveLazyInputs) {
+  mt19937 rng(4);
+  for (u32 p : kPrimes) {
+    NTT ntt(p);
+    const int n = 1024;
+    vector<u32> a(n);
+    for (auto &x : a) x = 2 * p - 1 - rng() % (rng() % 2 ? 16 : p);
+    for (int odd = 0; odd < 2; ++odd) {
+      // The same values, represented differently.
+      vector<u32> w = a, ref(n);
+      for (int i = 0; i < n; ++i) ref[i] = ntt.to_mont(ntt.from_mont(a[i]));
+      ntt.halve(w.data(), n, odd);
+      ntt.halve(ref.data(), n, odd);
+      for (int i = 0; i < n / 2; ++i) {
+        EXPECT_LT(w[i], 2 * p) << p << " " << i;
+        EXPECT_EQ(ntt.from_mont(w[i]), ntt.from_mont(ref[i])) << p << " " << i;
+      }
+    }
+  }
+}
+
+TEST(NTTTest, PrimitiveRoot) {
+  EXPECT_EQ(NTT::primitive_root(998244353), 3u);
+  for (u32 p : kPrimes) {
+    const u32 g = NTT::primitive_root(p);
+    EXPECT_EQ(pow_mod(g, p - 1, p), 1u);
+    EXPECT_NE(pow_mod(g, (p - 1) / 2, p), 1u);
+  }
+}
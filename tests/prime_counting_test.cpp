@@ -0,0 +1,46 @@
+#include <bits/stdc++.h>
+
+#include "../src/factorization.hpp"
+#include "../src/prime_counting.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(PrimeCountingTest, AgainstSieve) {
+  const int N = 100000;
+  const vector<bool> sieve = prime_sieve(N);
+  vector<Int> count(N + 1), sum(N + 1);
+  for (int i = 1; i <= N; ++i) {
+    count[i] = count[i - 1] + sieve[i];
+    sum[i] = sum[i - 1] + (sieve[i] ? i : 0);
+  }
+  for (Int n : {0, 1, 2, 3, 4, 10, 97, 1000, 65536, 99991, 100000}) {
+    for (int num_threads : {1, 2}) {
+      EXPECT_EQ(prime_count(n, num_threads), count[n]) << n;
+      EXPECT_TRUE(prime_sum(n, num_threads) == sum[n]) << n;
+    }
+  }
+}
+
+TEST(PrimeCountingTest, AllFloorValues) {
+  const Int n = 100000;
+  const vector<bool> sieve = prime_sieve(n);
+  const FloorValues fv(n);
+  const auto S = lucy_prime_sums<Int>(
+      fv, [](Int v) { return v - 1; }, [](Int) { return Int(1); });
+  ASSERT_EQ(int(S.size()), fv.size());
+  for (int i = 0; i < fv.size(); ++i) {
+    const Int v = fv.values[i];
+    EXPECT_EQ(fv.index(v), i);
+    EXPECT_EQ(S[i], count_if(sieve.begin(), sieve.begin() + v + 1,
+                             [](bool b) { return b; }))
+        << v;
+  }
+}
+
+TEST(PrimeCountingTest, Large) {
+  // Uses the multithreaded path (more than 2^16 floor values).
+  const Int n = 10'000'000'000LL;
+  EXPECT_EQ(prime_count(n, 3), 455052511);
+  EXPECT_TRUE(prime_sum(n, 3) == prime_sum(n, 1));
+}
@@ -1,5 +1,6 @@
 #include <bits/stdc++.h>
 
+#include "../src/modint.hpp"
 #include "../src/rational.hpp"
 #include "gtest/gtest.h"
 
@@ -32,3 +33,15 @@ TEST(RationalTest, Arithmetic) {
   EXPECT_EQ(Rat(29, 13) * Rat(26, 29), Rat(2, 1));
   EXPECT_EQ(Rat(29, 13) / Rat(29, 26), Rat(2, 1));
 }
+
+TEST(RationalTest, ToModint) {
+  using Mint = ModInt<1000000007>;
+  const vector<Rat> xs = {Rat(1, 2), Rat(-2, 3), Rat(0), Rat(5), Rat(7, 9)};
+  const vector<Mint> res = to_modint<Mint>(xs);
+  ASSERT_EQ(res.size(), xs.size());
+  for (int i = 0; i < int(xs.size()); ++i) {
+    EXPECT_EQ(res[i] * Mint(xs[i].denominator()), Mint(xs[i].numerator()));
+  }
+  EXPECT_EQ(res[0].val(), 500000004);
+  EXPECT_TRUE(to_modint<Mint>({}).empty());
+}
@@ -0,0 +1,205 @@
+#include <bits/stdc++.h>
+
+#include "../src/modint.hpp"
+#include "../src/factorization.hpp"
+#include "../src/zeta_moebius_transform.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using Mint = ModInt<998244353>;
+
+namespace {
+
+vector<Mint> random_vector(int n, mt19937 &rng) {
+  vector<Mint> res(n);
+  for (auto &x : res) x = rng();
+  return res;
+}
+
+}  // namespace
+
+TEST(ZetaMoebiusTest, SubsetSuperset) {
+  mt19937 rng(1);
+  for (int bits = 0; bits <= 13; ++bits) {
+    const int N = 1 << bits;
+    const vector<Mint> f = random_vector(N, rng);
+    vector<Mint> sub(N), sup(N);
+    for (int S = 0; S < N; ++S) {
+      for (int T = S;; T = (T - 1) & S) {
+        sub[S] += f[T];
+        sup[T] += f[S];
+        if (T == 0) break;
+      }
+    }
+    for (int num_threads : {1, 3}) {
+      vector<Mint> g = f;
+      subset_zeta_transform(g, num_threads);
+      EXPECT_EQ(g, sub) << bits;
+      subset_moebius_transform(g, num_threads);
+      EXPECT_EQ(g, f) << bits;
+      superset_zeta_transform(g, num_threads);
+      EXPECT_EQ(g, sup) << bits;
+      superset_moebius_transform(g, num_threads);
+      EXPECT_EQ(g, f) << bits;
+    }
+  }
+}
+
+TEST(ZetaMoebiusTest, ThreadsLarge) {
+  // 2^18: several high-bit groups, split across threads.
+  mt19937 rng(2);
+  const vector<Mint> f = random_vector(1 << 18, rng);
+  vector<Mint> a = f, b = f;
+  subset_zeta_transform(a);
+  subset_zeta_transform(b, 4);
+  EXPECT_EQ(a, b);
+  walsh_hadamard_transform(a);
+  walsh_hadamard_transform(b, 4);
+  EXPECT_EQ(a, b);
+}
+
+TEST(ZetaMoebiusTest, BitwiseConvolutions) {
+  mt19937 rng(3);
+  for (int bits = 0; bits <= 8; ++bits) {
+    const int N = 1 << bits;
+    const vector<Mint> f = random_vector(N, rng), g = random_vector(N, rng);
+    vector<Mint> h_or(N), h_and(N), h_xor(N);
+    vector<Int> fi(N), gi(N), hi_xor(N);
+    for (int i = 0; i < N; ++i) fi[i] = rng() % 100 - 50, gi[i] = rng() % 100;
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        h_or[i | j] += f[i] * g[j];
+        h_and[i & j] += f[i] * g[j];
+        h_xor[i ^ j] += f[i] * g[j];
+        hi_xor[i ^ j] += fi[i] * gi[j];
+      }
+    }
+    for (int num_threads : {1, 2}) {
+      EXPECT_EQ(bitwise_or_convolution(f, g, num_threads), h_or) << bits;
+      EXPECT_EQ(bitwise_and_convolution(f, g, num_threads), h_and) << bits;
+      EXPECT_EQ(bitwise_xor_convolution(f, g, num_threads), h_xor) << bits;
+      EXPECT_EQ(bitwise_xor_convolution(fi, gi, num_threads), hi_xor)
+          << bits;
+    }
+  }
+}
+
+TEST(ZetaMoebiusTest, WalshHadamardTwice) {
+  mt19937 rng(4);
+  for (int bits : {0, 1, 3, 12, 14}) {
+    const int N = 1 << bits;
+    const vector<Mint> f = random_vector(N, rng);
+    vector<Mint> g = f;
+    walsh_hadamard_transform(g, 2);
+    walsh_hadamard_transform(g, 2);
+    for (int i = 0; i < N; ++i) ASSERT_EQ(g[i], f[i] * N) << bits << " " << i;
+    vector<double> d(N);
+    for (int i = 0; i < N; ++i) d[i] = int(rng() % 7) - 3;
+    vector<double> e = d;
+    walsh_hadamard_transform(e);
+    walsh_hadamard_transform(e);
+    for (int i = 0; i < N; ++i) ASSERT_EQ(e[i], d[i] * N) << bits << " " << i;
+  }
+}
+
+TEST(ZetaMoebiusTest, SubsetConvolution) {
+  mt19937 rng(5);
+  for (int bits = 0; bits <= 10; ++bits) {
+    const int N = 1 << bits;
+    const vector<Mint> f = random_vector(N, rng), g = random_vector(N, rng);
+    vector<Mint> h(N);
+    for (int S = 0; S < N; ++S) {
+      for (int T = S;; T = (T - 1) & S) {
+        h[S] += f[T] * g[S ^ T];
+        if (T == 0) break;
+      }
+    }
+    for (int num_threads : {1, 2}) {
+      EXPECT_EQ(subset_convolution(f, g, num_threads), h) << bits;
+    }
+  }
+}
+
+TEST(ZetaMoebiusTest, SetPowerSeries) {
+  // h(S) = #graphs on S = 2^C(|S|, 2); log(h)(S) = #connected graphs on S.
+  const vector<int> connected = {0, 1, 1, 4, 38, 728, 26704, 1866256};
+  for (int bits = 0; bits <= 7; ++bits) {
+    const int N = 1 << bits;
+    vector<Mint> h(N);
+    for (int S = 0; S < N; ++S) {
+      const int k = __builtin_popcount(S);
+      h[S] = Mint(2).pow(k * (k - 1) / 2);
+    }
+    const vector<Mint> f = set_power_series_log(h, 2);
+    for (int S = 0; S < N; ++S) {
+      ASSERT_EQ(f[S], Mint(connected[__builtin_popcount(S)])) << S;
+    }
+    EXPECT_EQ(set_power_series_exp(f, 2), h) << bits;
+  }
+  mt19937 rng(6);
+  for (int bits = 0; bits <= 10; ++bits) {
+    vector<Mint> f = random_vector(1 << bits, rng);
+    f[0] = 0;
+    EXPECT_EQ(set_power_series_log(set_power_series_exp(f)), f) << bits;
+  }
+}
+
+TEST(ZetaMoebiusTest, GcdLcmConvolution) {
+  mt19937 rng(7);
+  const vector<int> primes = LinearSieve(1 << 18).primes;
+  for (int n : {1, 2, 3, 10, 97, 300}) {
+    vector<Mint> f = random_vector(n, rng), g = random_vector(n, rng);
+    if (n > 0) f[0] = g[0] = 0;  // index 0 is not used
+    vector<Mint> h_gcd(n), h_lcm(n);
+    for (int i = 1; i < n; ++i) {
+      for (int j = 1; j < n; ++j) {
+        h_gcd[gcd(i, j)] += f[i] * g[j];
+        if (const Int l = lcm<Int>(i, j); l < n) h_lcm[l] += f[i] * g[j];
+      }
+    }
+    EXPECT_EQ(gcd_convolution(f, g, primes), h_gcd) << n;
+    EXPECT_EQ(lcm_convolution(f, g, primes), h_lcm) << n;
+    const GcdConvolutionPlan<Mint> gcd_plan(g, primes);
+    const LcmConvolutionPlan<Mint> lcm_plan(g, primes);
+    vector<Mint> a = f, b = f;
+    gcd_plan.apply(a);
+    lcm_plan.apply(b);
+    EXPECT_EQ(a, h_gcd) << n;
+    EXPECT_EQ(b, h_lcm) << n;
+  }
+}
+
+TEST(ZetaMoebiusTest, DivisorChainsThreaded) {
+  // n / 2 >= 2^16: small primes take the multithreaded chain path.
+  mt19937 rng(8);
+  const int n = 300000;
+  const vector<int> primes = LinearSieve(n).primes;
+  const vector<Mint> f = random_vector(n, rng);
+  for (int num_threads : {2, 3}) {
+    vector<Mint> a = f, b = f;
+    divisor_zeta_transform(a, primes);
+    divisor_zeta_transform(b, primes, num_threads);
+    EXPECT_EQ(a, b);
+    divisor_moebius_transform(b, primes, num_threads);
+    EXPECT_EQ(b, f);
+    a = f, b = f;
+    multiple_zeta_transform(a, primes);
+    multiple_zeta_transform(b, primes, num_threads);
+    EXPECT_EQ(a, b);
+    multiple_moebius_transform(b, primes, num_threads);
+    EXPECT_EQ(b, f);
+  }
+  // Spot checks of the definitions.
+  vector<Mint> a = f, b = f;
+  divisor_zeta_transform(a, primes, 2);
+  multiple_zeta_transform(b, primes, 2);
+  for (int k : {1, 2, 720, 65536, 277200, n - 1}) {
+    Mint div_sum = 0, mul_sum = 0;
+    for (int d = 1; d <= k; ++d) {
+      if (k % d == 0) div_sum += f[d];
+    }
+    for (int m = k; m < n; m += k) mul_sum += f[m];
+    EXPECT_EQ(a[k], div_sum) << k;
+    EXPECT_EQ(b[k], mul_sum) << k;
+  }
+}